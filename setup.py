@@ -250,6 +250,7 @@ setup(
         'Programming Language :: Python :: 3.11',
         'Programming Language :: Python :: 3.12',
         'Programming Language :: Python :: 3.13',
+        'Programming Language :: Python :: Free Threading :: 2 - Beta',
         'Programming Language :: Python :: Implementation :: CPython',
         'Operating System :: Unix',
         'Operating System :: MacOS',
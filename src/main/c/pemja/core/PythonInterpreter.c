@@ -99,6 +99,106 @@ JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_finalize(JNIEnv *env,
   JcpPy_FinalizeThread(ptr);
 }
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    setConversionPolicy
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_setConversionPolicy(
+    JNIEnv *env, jobject obj, jlong ptr, jint policy) {
+  JcpPy_SetConversionPolicy((intptr_t)ptr, policy);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    beginSession
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_beginSession(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  JcpPy_BeginSession((intptr_t)ptr);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    endSession
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_endSession(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  JcpPy_EndSession((intptr_t)ptr);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    saveGlobals
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_pemja_core_PythonInterpreter_saveGlobals(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  return JcpPy_SaveGlobals((intptr_t)ptr) == 0;
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    restoreGlobals
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_pemja_core_PythonInterpreter_restoreGlobals(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  return JcpPy_RestoreGlobals((intptr_t)ptr) == 0;
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    detach
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_detach(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  JcpPy_DetachThread((intptr_t)ptr);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    attach
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_attach(
+    JNIEnv *env, jobject obj, jlong ptr) {
+  JcpPy_AttachThread(env, (intptr_t)ptr);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    interrupt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_interrupt(
+    JNIEnv *env, jobject obj, jlong ptr, jlong id) {
+  JcpPy_Interrupt((intptr_t)ptr, id);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    armInterrupt
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_pemja_core_PythonInterpreter_armInterrupt(
+    JNIEnv *env, jobject obj, jlong ptr, jlong id) {
+  return JcpPy_ArmInterrupt((intptr_t)ptr, id);
+}
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    disarmInterrupt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_disarmInterrupt(
+    JNIEnv *env, jobject obj, jlong ptr, jlong enclosing) {
+  JcpPy_DisarmInterrupt((intptr_t)ptr, enclosing);
+}
+
 // ----------------------------------------------------------------------
 
 // ------------------------------ set()/get methods----------------------
@@ -368,6 +468,22 @@ JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_invoke(
   return result;
 }
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    invokeAsync
+ * Signature:
+ * (JLjava/lang/String;[Ljava/lang/Object;Ljava/util/concurrent/CompletableFuture;)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_invokeAsync(
+    JNIEnv *env, jobject obj, jlong ptr, jstring name, jobjectArray args,
+    jobject future) {
+  const char *cname;
+
+  cname = JcpString_FromJString(env, name);
+  JcpPyObject_CallAsync(env, (intptr_t)ptr, cname, args, future);
+  JcpString_Clear(env, name, cname);
+}
+
 /*
  * Class:     pemja_core_PythonInterpreter
  * Method:    invokeMethodNoArgs
@@ -543,6 +659,16 @@ JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_invokeMethod(
 
 // ----------------------------------------------------------------------
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    importRecordBatch
+ * Signature: (JJJ)Lpemja/core/object/PyObject;
+ */
+JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_importRecordBatch(
+    JNIEnv *env, jobject obj, jlong ptr, jlong array, jlong schema) {
+  return JcpPyArrow_ImportRecordBatch(env, (intptr_t)ptr, array, schema);
+}
+
 /*
  * Class:     pemja_core_PythonInterpreter
  * Method:    exec
@@ -558,3 +684,17 @@ JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_exec(JNIEnv *env,
   JcpExec(env, (intptr_t)ptr, code);
   JcpString_Clear(env, jcode, code);
 }
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    execTemplate
+ * Signature: (JLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_execTemplate(
+    JNIEnv *env, jobject obj, jlong ptr, jstring jcode) {
+  const char *code;
+
+  code = JcpString_FromJString(env, jcode);
+  JcpExecTemplate(env, (intptr_t)ptr, code);
+  JcpString_Clear(env, jcode, code);
+}
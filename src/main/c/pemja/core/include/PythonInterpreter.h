@@ -39,6 +39,88 @@ JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_finalize(JNIEnv *,
                                                                   jobject,
                                                                   jlong);
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    setConversionPolicy
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_setConversionPolicy(
+    JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    beginSession
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_beginSession(JNIEnv *,
+                                                                      jobject,
+                                                                      jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    endSession
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_endSession(JNIEnv *,
+                                                                    jobject,
+                                                                    jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    saveGlobals
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_pemja_core_PythonInterpreter_saveGlobals(JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    restoreGlobals
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_pemja_core_PythonInterpreter_restoreGlobals(JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    detach
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_detach(JNIEnv *,
+                                                                jobject, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    attach
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_attach(JNIEnv *,
+                                                                jobject, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    interrupt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_interrupt(
+    JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    armInterrupt
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_pemja_core_PythonInterpreter_armInterrupt(
+    JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    disarmInterrupt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_disarmInterrupt(
+    JNIEnv *, jobject, jlong, jlong);
+
 // ------------------------------ set()/get methods----------------------
 
 /*
@@ -188,6 +270,15 @@ JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_invoke(
   JcpString_Clear(env, jmethodname, methodname); \
   }
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    invokeAsync
+ * Signature:
+ * (JLjava/lang/String;[Ljava/lang/Object;Ljava/util/concurrent/CompletableFuture;)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_invokeAsync(
+    JNIEnv *, jobject, jlong, jstring, jobjectArray, jobject);
+
 /*
  * Class:     pemja_core_PythonInterpreter
  * Method:    invokeMethodNoArgs
@@ -267,6 +358,14 @@ Java_pemja_core_PythonInterpreter_invokeMethodOneArgObject(JNIEnv *, jobject,
 JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_invokeMethod(
     JNIEnv *, jobject, jlong, jstring, jstring, jobjectArray);
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    importRecordBatch
+ * Signature: (JJJ)Lpemja/core/object/PyObject;
+ */
+JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_importRecordBatch(
+    JNIEnv *, jobject, jlong, jlong, jlong);
+
 /*
  * Class:     pemja_core_PythonInterpreter
  * Method:    exec
@@ -275,6 +374,14 @@ JNIEXPORT jobject JNICALL Java_pemja_core_PythonInterpreter_invokeMethod(
 JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_exec(JNIEnv *, jobject,
                                                               jlong, jstring);
 
+/*
+ * Class:     pemja_core_PythonInterpreter
+ * Method:    execTemplate
+ * Signature: (JLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_pemja_core_PythonInterpreter_execTemplate(
+    JNIEnv *, jobject, jlong, jstring);
+
 #ifdef __cplusplus
 }
 #endif
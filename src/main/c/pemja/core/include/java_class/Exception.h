@@ -17,5 +17,6 @@
 #include <jni.h>
 
 jobject JavaPythonException_New(JNIEnv*, jstring);
+jobject JavaPythonTimeoutException_New(JNIEnv*, jstring);
 
 #endif
@@ -20,7 +20,9 @@
 #include <java_class/Byte.h>
 #include <java_class/Character.h>
 #include <java_class/Class.h>
+#include <java_class/ClassUtils.h>
 #include <java_class/Collection.h>
+#include <java_class/CompletableFuture.h>
 #include <java_class/Constructor.h>
 #include <java_class/Date.h>
 #include <java_class/Double.h>
@@ -31,6 +33,7 @@
 #include <java_class/Integer.h>
 #include <java_class/Iterable.h>
 #include <java_class/Iterator.h>
+#include <java_class/IteratorUtils.h>
 #include <java_class/List.h>
 #include <java_class/LocalDate.h>
 #include <java_class/LocalDateTime.h>
@@ -42,7 +45,9 @@
 #include <java_class/Modifier.h>
 #include <java_class/Number.h>
 #include <java_class/Object.h>
+#include <java_class/PyDict.h>
 #include <java_class/PyIterator.h>
+#include <java_class/PyList.h>
 #include <java_class/PyObject.h>
 #include <java_class/Short.h>
 #include <java_class/StackTraceElement.h>
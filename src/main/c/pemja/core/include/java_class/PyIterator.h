@@ -22,12 +22,11 @@ extern "C" {
 #endif
 /*
  * Class:     pemja_core_object_PyIterator
- * Method:    next
- * Signature: (JJ)Ljava/lang/Object;
+ * Method:    nextChunk
+ * Signature: (JJI)[Ljava/lang/Object;
  */
-JNIEXPORT jobject JNICALL Java_pemja_core_object_PyIterator_next(JNIEnv *,
-                                                                 jobject, jlong,
-                                                                 jlong);
+JNIEXPORT jobjectArray JNICALL Java_pemja_core_object_PyIterator_nextChunk(
+    JNIEnv *, jobject, jlong, jlong, jint);
 
 jobject JavaPyIterator_New(JNIEnv *, jlong, jlong);
 
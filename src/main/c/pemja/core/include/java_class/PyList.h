@@ -0,0 +1,63 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _Included_pemja_core_object_PyList
+#define _Included_pemja_core_object_PyList
+
+#include <jni.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     pemja_core_object_PyList
+ * Method:    size
+ * Signature: (JJ)I
+ */
+JNIEXPORT jint JNICALL Java_pemja_core_object_PyList_size(JNIEnv *, jobject,
+                                                          jlong, jlong);
+
+/*
+ * Class:     pemja_core_object_PyList
+ * Method:    get
+ * Signature: (JJI)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_pemja_core_object_PyList_get(JNIEnv *, jobject,
+                                                            jlong, jlong, jint);
+
+/*
+ * Class:     pemja_core_object_PyList
+ * Method:    contains
+ * Signature: (JJLjava/lang/Object;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_pemja_core_object_PyList_contains(JNIEnv *,
+                                                                  jobject,
+                                                                  jlong, jlong,
+                                                                  jobject);
+
+/*
+ * Class:     pemja_core_object_PyList
+ * Method:    toArray
+ * Signature: (JJ)[Ljava/lang/Object;
+ */
+JNIEXPORT jobjectArray JNICALL Java_pemja_core_object_PyList_toArray(JNIEnv *,
+                                                                     jobject,
+                                                                     jlong,
+                                                                     jlong);
+
+jobject JavaPyList_New(JNIEnv *, jlong, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
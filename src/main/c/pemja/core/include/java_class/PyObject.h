@@ -70,6 +70,17 @@ JNIEXPORT jobject JNICALL Java_pemja_core_object_PyObject_invokeMethodOneArg(
 JNIEXPORT jobject JNICALL Java_pemja_core_object_PyObject_invokeMethod(
     JNIEnv *, jobject, jlong, jlong, jstring, jobjectArray);
 
+/*
+ * Class:     pemja_core_object_PyObject
+ * Method:    call
+ * Signature: (JJ[Ljava/lang/Object;Ljava/lang/Class;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_pemja_core_object_PyObject_call(JNIEnv *,
+                                                              jobject, jlong,
+                                                              jlong,
+                                                              jobjectArray,
+                                                              jclass);
+
 jobject JavaPyObject_New(JNIEnv *, jlong, jlong);
 
 jlong JavaPyObject_GetPyobject(JNIEnv *, jobject);
@@ -22,4 +22,31 @@
 #define JcpAPI_DATA(RTYPE) extern Jcp_EXPORTED_SYMBOL RTYPE
 #endif
 
+/* The storage class of the variables local to a thread */
+#ifdef _MSC_VER
+#define Jcp_THREAD_LOCAL __declspec(thread)
+#else
+#define Jcp_THREAD_LOCAL __thread
+#endif
+
+/* Free-threaded Python has no GIL guarding the state shared by the threads */
+#ifdef Py_GIL_DISABLED
+#ifndef _MSC_VER
+#define Jcp_ATOMIC _Atomic
+#else
+#define Jcp_ATOMIC
+#endif
+#define Jcp_BEGIN_CRITICAL_SECTION(op) Py_BEGIN_CRITICAL_SECTION(op)
+#define Jcp_END_CRITICAL_SECTION() Py_END_CRITICAL_SECTION()
+#define Jcp_LOAD_ACQUIRE(value) _Py_atomic_load_int_acquire(&(value))
+#define Jcp_STORE_RELEASE(value, new_value) \
+  _Py_atomic_store_int_release(&(value), (new_value))
+#else
+#define Jcp_ATOMIC
+#define Jcp_BEGIN_CRITICAL_SECTION(op) {
+#define Jcp_END_CRITICAL_SECTION() }
+#define Jcp_LOAD_ACQUIRE(value) (value)
+#define Jcp_STORE_RELEASE(value, new_value) ((value) = (new_value))
+#endif
+
 #endif
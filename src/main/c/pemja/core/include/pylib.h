@@ -18,6 +18,18 @@
 
 #define DICT_KEY "jcp"
 
+/* Java collections are converted to Python objects proxying them lazily */
+#define JCP_LAZY_PROXY 0
+
+/* Java collections are copied into Python lists and dicts eagerly */
+#define JCP_EAGER_COPY 1
+
+/* The exec types of PythonInterpreterConfig.ExecType */
+#define JCP_EXEC_MULTI_THREAD 0
+#define JCP_EXEC_SUB_INTERPRETER 1
+#define JCP_EXEC_SUB_INTERPRETER_OWN_GIL 2
+#define JCP_EXEC_FREE_THREADED 3
+
 struct __JcpThread {
   /* The attached variable objects of the Thread */
   PyObject *globals;
@@ -43,25 +55,95 @@ struct __JcpThread {
   /* The cached callable object */
   PyObject *cache_callable;
 
-  /* A cached Dict which mappes class name to methods and fields.*/
+  /* The methods, fields and types of Java classes of a sub interpreter.*/
   PyObject *name_to_attrs;
+
+  /* The classes found by pemja.findClass in the JcpThread.*/
+  PyObject *name_to_class;
+
+  /* The policy of converting Java collections to Python objects. */
+  int conversion_policy;
+
+  /* The exec type of the Thread. */
+  int exec_type;
+
+  /* Whether the PyThreadState is held by a session of the Thread. */
+  int in_session;
+
+  /* The copy of the globals restored when the Thread is recycled. */
+  PyObject *globals_snapshot;
+
+  /* The interpreter of the Thread while it is detached. */
+  PyInterpreterState *interp;
+
+  /* The next detached Thread, which is finalized with the Main Interpreter
+   * unless it is attached again. */
+  struct __JcpThread *next_detached;
+
+  /* The id of the call which can be interrupted by its deadline, or 0. */
+  jlong interrupt_id;
+
+  /* The pemja.event_loop.EventLoop of the asynchronous calls, if started. */
+  PyObject *event_loop;
 };
 
 typedef struct __JcpThread JcpThread;
 
-#define Jcp_BEGIN_ALLOW_THREADS    \
-  {                                \
-    JcpThread *jcp_thread;         \
-    jcp_thread = (JcpThread *)ptr; \
-    PyEval_AcquireThread(jcp_thread->tstate);
+/* The state of the _pemja module, which every interpreter imports once. The
+ * Python types of pemja are heap types created by the module, so that the
+ * interpreters never share them. `PyJObject_Type` and the like refer to the
+ * types of the current interpreter. */
+typedef struct {
+  PyTypeObject *pyjobject_type;
+  PyTypeObject *pyjclass_type;
+  PyTypeObject *pyjiterable_type;
+  PyTypeObject *pyjiterator_type;
+  PyTypeObject *pyjbufferediterator_type;
+  PyTypeObject *pyjcollection_type;
+  PyTypeObject *pyjlist_type;
+  PyTypeObject *pyjdict_type;
+  PyTypeObject *pyjfieldreader_type;
+  PyTypeObject *pyjfieldwriter_type;
+  PyTypeObject *pyjmethod_type;
+  PyTypeObject *pyjconstructor_type;
+  PyTypeObject *pyjmultimethod_type;
+  PyTypeObject *pyjfield_type;
+
+  /* The exception raised in the calls interrupted by Java */
+  PyObject *timeout_error;
+} JcpModuleState;
+
+#if PY_MINOR_VERSION >= 13
+#define JcpThreadState_Current() PyThreadState_GetUnchecked()
+#else
+#define JcpThreadState_Current() _PyThreadState_UncheckedGet()
+#endif
 
-#define Jcp_END_ALLOW_THREADS               \
-  PyEval_ReleaseThread(jcp_thread->tstate); \
+/* The PyThreadState held by a session is only acquired again if it has been
+ * released meanwhile, e.g. by a Java method called from Python. */
+#define Jcp_BEGIN_ALLOW_THREADS                                          \
+  {                                                                      \
+    JcpThread *jcp_thread;                                               \
+    int jcp_attached;                                                    \
+    jcp_thread = (JcpThread *)ptr;                                       \
+    jcp_attached = jcp_thread->in_session &&                             \
+                   JcpThreadState_Current() == jcp_thread->tstate;       \
+    if (!jcp_attached) {                                                 \
+      PyEval_AcquireThread(jcp_thread->tstate);                          \
+    }
+
+#define Jcp_END_ALLOW_THREADS                 \
+  if (!jcp_attached) {                        \
+    PyEval_ReleaseThread(jcp_thread->tstate); \
+  }                                           \
   }
 
 JcpAPI_FUNC(JcpThread *) JcpThread_Get(void);
 
+JcpAPI_FUNC(JcpModuleState *) JcpModuleState_Get(void);
+
 JcpAPI_FUNC(JNIEnv *) JcpThreadEnv_Get(void);
+JcpAPI_FUNC(void) JcpThreadEnv_Detach(void);
 
 /* Initialization and finalization */
 JcpAPI_FUNC(void) JcpPy_setPythonHome(JNIEnv *, jstring);
@@ -70,6 +152,41 @@ JcpAPI_FUNC(void) JcpPy_Finalize(JavaVM *);
 JcpAPI_FUNC(intptr_t) JcpPy_InitThread(JNIEnv *, int);
 JcpAPI_FUNC(void) JcpPy_FinalizeThread(intptr_t);
 
+/* Set the policy of converting Java collections to Python objects */
+JcpAPI_FUNC(void) JcpPy_SetConversionPolicy(intptr_t, int);
+
+/* Hold the PyThreadState of the JcpThread across the calls of a session */
+JcpAPI_FUNC(void) JcpPy_BeginSession(intptr_t);
+JcpAPI_FUNC(void) JcpPy_EndSession(intptr_t);
+
+/* Recycle the JcpThread of a sub interpreter for another PythonInterpreter */
+JcpAPI_FUNC(int) JcpPy_SaveGlobals(intptr_t);
+JcpAPI_FUNC(int) JcpPy_RestoreGlobals(intptr_t);
+JcpAPI_FUNC(void) JcpPy_DetachThread(intptr_t);
+JcpAPI_FUNC(void) JcpPy_AttachThread(JNIEnv *, intptr_t);
+
+/* Interrupt the Python code run by the JcpThread from any other thread */
+JcpAPI_FUNC(void) JcpPy_Interrupt(intptr_t, jlong);
+JcpAPI_FUNC(jlong) JcpPy_ArmInterrupt(intptr_t, jlong);
+JcpAPI_FUNC(void) JcpPy_DisarmInterrupt(intptr_t, jlong);
+
+/* Function to get the cached methods and fields of a Java class */
+JcpAPI_FUNC(PyObject *) JcpClassAttrs_Get(JNIEnv *, jclass, PyObject *);
+
+/* Function to get the cached Python type of a Java class. Returns a new
+ * reference */
+JcpAPI_FUNC(PyTypeObject *) JcpClassType_Get(JNIEnv *, jclass, PyObject *);
+
+/* Function to check whether the Python types of Java classes can be created in
+ * the current thread */
+JcpAPI_FUNC(int) JcpClassType_Enabled(void);
+
+/* Function to cache the Python type of a Java class. Returns a new reference
+ * of the cached type, or NULL without an exception set if the type can't be
+ * cached in the current thread */
+JcpAPI_FUNC(PyTypeObject *)
+    JcpClassType_Put(JNIEnv *, jclass, PyObject *, PyTypeObject *);
+
 /* Add path to search path of Main Interpreter */
 JcpAPI_FUNC(void) JcpPy_AddSearchPath(JNIEnv *, jstring);
 
@@ -334,6 +451,10 @@ JcpAPI_FUNC(jobject)
 JcpAPI_FUNC(jobject)
     JcpPyObject_Call(JNIEnv *, intptr_t, const char *, jobjectArray, jobject);
 
+/* Call a coroutine function, whose coroutine completes the Java future */
+JcpAPI_FUNC(void) JcpPyObject_CallAsync(JNIEnv *, intptr_t, const char *,
+                                        jobjectArray, jobject);
+
 static inline jobject _JcpPyObject_Call_MethodOneArg(JNIEnv *env,
                                                      JcpThread *jcp_thread,
                                                      const char *obj,
@@ -404,7 +525,15 @@ JcpAPI_FUNC(jobject) JcpPyObject_CallMethod(JNIEnv *, intptr_t, const char *,
 
 // ----------------------------------------------------------------------------------------
 
+/* Import an Arrow C Data Interface ArrowArray/ArrowSchema pair as a
+ * pyarrow.RecordBatch */
+JcpAPI_FUNC(jobject)
+    JcpPyArrow_ImportRecordBatch(JNIEnv *, intptr_t, jlong, jlong);
+
 /* Exec python code */
 JcpAPI_FUNC(void) JcpExec(JNIEnv *, intptr_t, const char *);
 
+/* Exec the warm-up code once in a template copied to the globals */
+JcpAPI_FUNC(void) JcpExecTemplate(JNIEnv *, intptr_t, const char *);
+
 #endif  // ifndef _Included_pylib
\ No newline at end of file
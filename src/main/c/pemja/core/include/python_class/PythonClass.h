@@ -14,11 +14,13 @@
 #ifndef PYTHON_CLASS_H
 #define PYTHON_CLASS_H
 
+#include <python_class/pyjbufferediterator.h>
 #include <python_class/pyjclass.h>
 #include <python_class/pyjcollection.h>
 #include <python_class/pyjconstructor.h>
 #include <python_class/pyjdict.h>
 #include <python_class/pyjfield.h>
+#include <python_class/pyjfieldaccessor.h>
 #include <python_class/pyjiterable.h>
 #include <python_class/pyjiterator.h>
 #include <python_class/pyjlist.h>
@@ -0,0 +1,49 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _Included_pyjbufferediterator
+#define _Included_pyjbufferediterator
+
+#include "pyjobject.h"
+
+/* The number of elements fetched from the Java Iterator by one JNI call */
+#define JCP_ITERATOR_CHUNK_SIZE 64
+
+typedef struct {
+  PyJOjbect_HEAD
+
+      /* The elements fetched from the Java Iterator but not consumed yet */
+      PyObject *chunk;
+
+  /* The position of the next element in the chunk */
+  Py_ssize_t position;
+
+  /* Whether the end of the Java Iterator has been reached */
+  int exhausted;
+} PyJBufferedIteratorObject;
+
+JcpAPI_DATA(PyType_Spec) PyJBufferedIterator_Spec;
+#define PyJBufferedIterator_Type \
+  (*JcpModuleState_Get()->pyjbufferediterator_type)
+
+/* Public interface */
+
+/* Creates a new PyJBufferedIteratorObject with a Java Iterator Object. */
+JcpAPI_FUNC(PyObject *) JcpPyJBufferedIterator_New(JNIEnv *, jobject, jclass);
+
+#define PyJBufferedIterator_Check(op) \
+  PyObject_TypeCheck(op, &PyJBufferedIterator_Type)
+#define PyJBufferedIterator_CheckExact(op) \
+  op->ob_type == &PyJBufferedIterator_Type
+
+#endif
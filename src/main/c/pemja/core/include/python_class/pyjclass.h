@@ -23,7 +23,8 @@ typedef struct {
       PyObject *constructor;
 } PyJClassObject;
 
-JcpAPI_DATA(PyTypeObject) PyJClass_Type;
+JcpAPI_DATA(PyType_Spec) PyJClass_Spec;
+#define PyJClass_Type (*JcpModuleState_Get()->pyjclass_type)
 
 /* Public interface */
 
@@ -14,12 +14,13 @@
 #ifndef _Included_pyjcollection
 #define _Included_pyjcollection
 
-JcpAPI_DATA(PyTypeObject) PyJCollection_Type;
+JcpAPI_DATA(PyType_Spec) PyJCollection_Spec;
+#define PyJCollection_Type (*JcpModuleState_Get()->pyjcollection_type)
 
 /* Public interface */
 JcpAPI_FUNC(PyObject*) JcpPyJCollection_New(JNIEnv*, jobject, jclass);
 
-#define PyJCollection_Check(op) PyObject_TypeCheck(op, &PyJICollection_Type)
-#define PyJCollection_CheckExact(op) op->ob_type == &PyJICollection_Type
+#define PyJCollection_Check(op) PyObject_TypeCheck(op, &PyJCollection_Type)
+#define PyJCollection_CheckExact(op) op->ob_type == &PyJCollection_Type
 
 #endif
@@ -14,7 +14,8 @@
 #ifndef _Included_pyjconstructor
 #define _Included_pyjconstructor
 
-JcpAPI_DATA(PyTypeObject) PyJConstructor_Type;
+JcpAPI_DATA(PyType_Spec) PyJConstructor_Spec;
+#define PyJConstructor_Type (*JcpModuleState_Get()->pyjconstructor_type)
 
 /* Public interface */
 
@@ -14,7 +14,8 @@
 #ifndef PEMJA_PYJDICT_H
 #define PEMJA_PYJDICT_H
 
-JcpAPI_DATA(PyTypeObject) PyJDict_Type;
+JcpAPI_DATA(PyType_Spec) PyJDict_Spec;
+#define PyJDict_Type (*JcpModuleState_Get()->pyjdict_type)
 
 /* Public interface */
 JcpAPI_FUNC(PyObject*) JcpPyJDict_New(JNIEnv*, jobject, jclass);
@@ -39,19 +39,31 @@ typedef struct {
   int fd_is_initialized;
 } PyJFieldObject;
 
-JcpAPI_DATA(PyTypeObject) PyJField_Type;
+JcpAPI_DATA(PyType_Spec) PyJField_Spec;
+#define PyJField_Type (*JcpModuleState_Get()->pyjfield_type)
 
 /* Public interface */
 
 /* Creates a new PyJFieldObject with a Java Field Object. */
 JcpAPI_FUNC(PyJFieldObject*) JcpPyJField_New(JNIEnv*, jobject);
 
+/* Resolves the field ID and the type of the PyJFieldObject if required. */
+JcpAPI_FUNC(int) JcpPyJField_Init(JNIEnv*, PyJFieldObject*);
+
 /* Gets the filed of the PyJObject. */
 JcpAPI_FUNC(PyObject*) JcpPyJField_Get(PyJFieldObject*, PyJObject*);
 
+/* Gets the filed of the PyJObject with an initialized PyJFieldObject. */
+JcpAPI_FUNC(PyObject*)
+    JcpPyJField_GetValue(JNIEnv*, PyJFieldObject*, PyJObject*);
+
 /* Sets the field value of the PyJObject. */
 JcpAPI_FUNC(int) JcpPyJField_Set(PyJFieldObject*, PyJObject*, PyObject*);
 
+/* Sets the field value of the PyJObject with an initialized PyJFieldObject. */
+JcpAPI_FUNC(int)
+    JcpPyJField_SetValue(JNIEnv*, PyJFieldObject*, PyJObject*, PyObject*);
+
 #define PyJField_Check(op) PyObject_TypeCheck(op, &PyJField_Type)
 #define PyJField_CheckExact(op) Py_IS_TYPE(op, &PyJField_Type)
 
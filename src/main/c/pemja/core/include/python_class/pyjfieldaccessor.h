@@ -0,0 +1,38 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef _Included_pyjfieldaccessor
+#define _Included_pyjfieldaccessor
+
+typedef struct {
+  PyObject_HEAD
+
+      /* The Java class declaring the fields */
+      jclass clazz;
+
+  /* The tuple of the accessed PyJFieldObjects */
+  PyObject* fields;
+
+  /* The flag decides whether there are non-static fields */
+  int has_instance_fields;
+} PyJFieldAccessorObject;
+
+/* Reads a fixed list of fields of Java objects into a tuple in one pass. */
+JcpAPI_DATA(PyType_Spec) PyJFieldReader_Spec;
+#define PyJFieldReader_Type (*JcpModuleState_Get()->pyjfieldreader_type)
+
+/* Writes a fixed list of fields of Java objects in one pass. */
+JcpAPI_DATA(PyType_Spec) PyJFieldWriter_Spec;
+#define PyJFieldWriter_Type (*JcpModuleState_Get()->pyjfieldwriter_type)
+
+#endif
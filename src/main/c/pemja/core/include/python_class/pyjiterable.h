@@ -14,7 +14,8 @@
 #ifndef _Included_pyjiterable
 #define _Included_pyjiterable
 
-JcpAPI_DATA(PyTypeObject) PyJIterable_Type;
+JcpAPI_DATA(PyType_Spec) PyJIterable_Spec;
+#define PyJIterable_Type (*JcpModuleState_Get()->pyjiterable_type)
 
 /* Public interface */
 JcpAPI_FUNC(PyObject*) JcpPyJIterable_New(JNIEnv*, jobject, jclass);
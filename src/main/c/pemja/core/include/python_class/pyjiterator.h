@@ -14,7 +14,8 @@
 #ifndef _Included_pyjiterator
 #define _Included_pyjiterator
 
-JcpAPI_DATA(PyTypeObject) PyJIterator_Type;
+JcpAPI_DATA(PyType_Spec) PyJIterator_Spec;
+#define PyJIterator_Type (*JcpModuleState_Get()->pyjiterator_type)
 
 /* Public interface */
 JcpAPI_FUNC(PyObject*) JcpPyJIterator_New(JNIEnv*, jobject, jclass);
@@ -14,7 +14,8 @@
 #ifndef PEMJA_PYJLIST_H
 #define PEMJA_PYJLIST_H
 
-JcpAPI_DATA(PyTypeObject) PyJList_Type;
+JcpAPI_DATA(PyType_Spec) PyJList_Spec;
+#define PyJList_Type (*JcpModuleState_Get()->pyjlist_type)
 
 /* Public interface */
 JcpAPI_FUNC(PyObject*) JcpPyJList_New(JNIEnv*, jobject, jclass);
@@ -14,6 +14,23 @@
 #ifndef _Included_pyjmethod
 #define _Included_pyjmethod
 
+/* The max number of arguments passed to a Java method without allocation */
+#define JCP_METHOD_STACK_ARGS 8
+
+/* The number of calls made with one release of the GIL by a mapped call */
+#define JCP_METHOD_MAP_CHUNK_SIZE 64
+
+typedef struct {
+  /* The class type of the parameter */
+  jclass type;
+
+  /* The type id of the parameter */
+  int type_id;
+
+  /* The converter of Python objects to the parameter */
+  JcpPyObject_JValueConverter converter;
+} PyJMethodParam;
+
 typedef struct {
   PyObject_HEAD
 
@@ -26,29 +43,49 @@ typedef struct {
   /* The method name */
   PyObject *md_name;
 
-  /* The param array class types of the method */
-  jobjectArray md_params;
-
   /* The num of the method params */
   int md_params_num;
 
+  /* The precomputed descriptors of the method params */
+  PyJMethodParam *md_param_types;
+
+  /* The flag decides whether it is a variable arity method */
+  int md_is_varargs;
+
+  /* The flag decides whether the call creates Java local references */
+  int md_needs_local_frame;
+
   /* The return type id of the method */
   int md_return_id;
 
   /* The flag decides whether it is a static method */
   int md_is_static;
+
+  /* The flag decides whether the GIL is kept during the Java call */
+  int md_keeps_gil;
+
+  /* The flag decides whether the method has been initialized */
+  int md_is_initialized;
 } PyJMethodObject;
 
-JcpAPI_DATA(PyTypeObject) PyJMethod_Type;
+JcpAPI_DATA(PyType_Spec) PyJMethod_Spec;
+#define PyJMethod_Type (*JcpModuleState_Get()->pyjmethod_type)
 
 /* Public interface */
 
 /* Creates a new PyJMethodObject with a Java Method Object. */
 JcpAPI_FUNC(PyJMethodObject *) JcpPyJMethod_New(JNIEnv *, jobject);
 
+/* Precomputes the descriptors of the params of the method. */
+JcpAPI_FUNC(int) JcpPyJMethod_InitParams(JNIEnv *, PyJMethodObject *,
+                                         jobjectArray);
+
 /* Returns whether the input arguments can match the params of the method. */
 JcpAPI_FUNC(int) JcpPyJMethodMatch(PyJMethodObject *, PyObject *);
 
+/* Calls a bound Java method with every item of an iterable into a list. */
+JcpAPI_FUNC(PyObject *) JcpPyJMethod_Map(PyObject *, PyObject *, int);
+
 #define PyJMethod_Check(op) PyObject_TypeCheck(op, &PyJMethod_Type)
 #define PyJMethod_CheckExact(op) Py_IS_TYPE(op, &PyJMethod_Type)
 
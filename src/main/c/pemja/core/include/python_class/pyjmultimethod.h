@@ -14,14 +14,41 @@
 #ifndef _Included_pyjmultimethod
 #define _Included_pyjmultimethod
 
+/* The number of argument type signatures cached by a PyJMultiMethodObject */
+#define JCP_MULTI_METHOD_CACHE_SIZE 4
+
+/* The max number of arguments of a call whose matched method can be cached */
+#define JCP_MULTI_METHOD_CACHE_MAX_ARGS 8
+
+typedef struct {
+  /* The matched method, NULL if the entry is empty */
+  PyJMethodObject* method;
+
+  /* The number of the arguments */
+  Py_ssize_t nargs;
+
+  /* The Python types of the arguments */
+  PyTypeObject* types[JCP_MULTI_METHOD_CACHE_MAX_ARGS];
+
+  /* The Java classes of the PyJObject arguments, NULL for the others */
+  jclass classes[JCP_MULTI_METHOD_CACHE_MAX_ARGS];
+} PyJMultiMethodCacheEntry;
+
 typedef struct {
   PyObject_HEAD
 
       /* A list stores the underling PyJMethodObjects.*/
       PyObject* methods;
+
+  /* The matched methods cached by the types of the arguments */
+  PyJMultiMethodCacheEntry cache[JCP_MULTI_METHOD_CACHE_SIZE];
+
+  /* The index of the next cache entry to be replaced */
+  int cache_next;
 } PyJMultiMethodObject;
 
-JcpAPI_DATA(PyTypeObject) PyJMultiMethod_Type;
+JcpAPI_DATA(PyType_Spec) PyJMultiMethod_Spec;
+#define PyJMultiMethod_Type (*JcpModuleState_Get()->pyjmultimethod_type)
 
 /* Public interface */
 
@@ -32,6 +59,10 @@ JcpAPI_FUNC(PyJMultiMethodObject*) JcpPyJMultiMethod_New(void);
 JcpAPI_FUNC(int)
     JcpPyJMultiMethod_Append(PyJMultiMethodObject*, PyJMethodObject*);
 
+/* Resolves the PyJMethodObject matching the arguments best. */
+JcpAPI_FUNC(PyJMethodObject*)
+    JcpPyJMultiMethod_Resolve(PyJMultiMethodObject*, PyObject*);
+
 #define PyJMultiMethod_Check(op) PyObject_TypeCheck(op, &PyJMultiMethod_Type)
 #define PyJMultiMethod_CheckExact(op) Py_IS_TYPE(op, &PyJMultiMethod_Type)
 
@@ -26,7 +26,8 @@ typedef struct {
   PyJOjbect_HEAD
 } PyJObject;
 
-JcpAPI_DATA(PyTypeObject) PyJObject_Type;
+JcpAPI_DATA(PyType_Spec) PyJObject_Spec;
+#define PyJObject_Type (*JcpModuleState_Get()->pyjobject_type)
 
 /* Public interface */
 
@@ -34,6 +35,9 @@ JcpAPI_DATA(PyTypeObject) PyJObject_Type;
 JcpAPI_FUNC(PyObject*)
     JcpPyJObject_New(JNIEnv*, PyTypeObject*, jobject, jclass);
 
+/* Gets the Java method or field of the given name of a PyJObject. */
+JcpAPI_FUNC(PyObject*) JcpPyJObject_GetMember(PyJObject*, PyObject*);
+
 #define PyJObject_Check(op) PyObject_TypeCheck(op, &PyJObject_Type)
 #define PyJObject_CheckExact(op) op->ob_type == &PyJObject_Type
 
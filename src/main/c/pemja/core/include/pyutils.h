@@ -53,11 +53,20 @@
   F(JMAP_TYPE, "java/util/Map")                                   \
   F(JHASHMAP_TYPE, "java/util/HashMap")                           \
   F(JMAP_ENTRY_TYPE, "java/util/Map$Entry")                       \
+  F(JCOMPLETABLE_FUTURE_TYPE,                                     \
+    "java/util/concurrent/CompletableFuture")                     \
   F(JILLEGAL_STATE_EXEC_TYPE, "java/lang/IllegalStateException")  \
   F(JNOSUCHELEMENT_EXEC_TYPE, "java/util/NoSuchElementException") \
+  F(JINDEX_OUT_OF_BOUNDS_EXEC_TYPE,                               \
+    "java/lang/IndexOutOfBoundsException")                        \
   F(JPYTHONEXCE_TYPE, "pemja/core/PythonException")               \
+  F(JPYTIMEOUTEXCE_TYPE, "pemja/core/PythonTimeoutException")     \
   F(JPYITERPRETER_TYPE, "pemja/core/object/PyIterator")           \
   F(JPYOBJECT_TYPE, "pemja/core/object/PyObject")                 \
+  F(JPYLIST_TYPE, "pemja/core/object/PyList")                     \
+  F(JPYDICT_TYPE, "pemja/core/object/PyDict")                     \
+  F(JITERATOR_UTILS_TYPE, "pemja/utils/IteratorUtils")            \
+  F(JCLASS_UTILS_TYPE, "pemja/utils/ClassUtils")                  \
   F(JTHROWABLE_TYPE, "java/lang/Throwable")                       \
   F(JSTACK_TRACE_ELEMENT_TYPE, "java/lang/StackTraceElement")     \
   F(JCONSTRUCTOR_TYPE, "java/lang/reflect/Constructor")           \
@@ -144,6 +153,9 @@ CLASS_TABLE(DEFINE_CLASS_GLOBAL)
 #define JMAP_ID 13
 #define JARRAY_ID 14
 
+/* Whether values of the Java Type ID are passed as Java Objects */
+#define JCP_IS_OBJECT_ID(id) ((id) >= JSTRING_ID && (id) != JVOID_ID)
+
 //  -------------------------------------------------------------------------------------
 
 /* Function to cache java classes in CLASS_TABLE */
@@ -168,6 +180,10 @@ JcpAPI_FUNC(int) JcpJObject_GetObjectId(JNIEnv *, jclass);
 /* Function to returns the match degree of the PyObject and the jclass */
 JcpAPI_FUNC(int) JcpPyObject_match(JNIEnv *, PyObject *, jclass);
 
+/* Function to returns the match degree of the PyObject and the jclass with the
+ * precomputed object id of the jclass */
+JcpAPI_FUNC(int) JcpPyObject_matchWithId(JNIEnv *, PyObject *, jclass, int);
+
 /* Function to return a Python Object from a Java Object */
 JcpAPI_FUNC(PyObject *) JcpPyObject_FromJObject(JNIEnv *, jobject);
 
@@ -251,6 +267,27 @@ JcpAPI_FUNC(jobject) JcpPyObject_AsJObject(JNIEnv *, PyObject *, jclass);
 /* Function to return a jvalue from a Python Object */
 JcpAPI_FUNC(jvalue) JcpPyObject_AsJValue(JNIEnv *, PyObject *, jclass);
 
+/* Function to convert a Python Object to a jvalue of the Java Class */
+typedef jvalue (*JcpPyObject_JValueConverter)(JNIEnv *, PyObject *, jclass);
+
+/* Function to return the converter of Python Objects to jvalues of the Java
+ * Class with the object id, so that it can be resolved only once per Java
+ * method parameter */
+JcpAPI_FUNC(JcpPyObject_JValueConverter) JcpPyObject_GetJValueConverter(int);
+
+static inline jvalue _JcpPyObject_AsJValue(
+    JNIEnv *env, PyObject *pyobject, jclass clazz,
+    JcpPyObject_JValueConverter converter) {
+  jvalue result;
+
+  if (pyobject == Py_None) {
+    result.l = NULL;
+    return result;
+  }
+
+  return converter(env, pyobject, clazz);
+}
+
 /* Functions to return a Java primitive value from a Python primitive object */
 JcpAPI_FUNC(jboolean) JcpPyBool_AsJBoolean(PyObject *);
 JcpAPI_FUNC(jbyte) JcpPyInt_AsJByte(PyObject *);
@@ -313,6 +350,12 @@ JcpAPI_FUNC(jobject) JcpPyDecimal_AsJObject(JNIEnv *, PyObject *, jclass);
 /* Function to return a Java Generator Object from a Python Generator object */
 JcpAPI_FUNC(jobject) JcpPyGenerator_AsJObject(JNIEnv *, PyObject *);
 
+/* Function to return a Java PyList view over a Python List */
+JcpAPI_FUNC(jobject) JcpPyList_AsJPyList(JNIEnv *, PyObject *);
+
+/* Function to return a Java PyDict view over a Python Dict */
+JcpAPI_FUNC(jobject) JcpPyDict_AsJPyDict(JNIEnv *, PyObject *);
+
 /* Function to return a Java PyObject from a Python object */
 JcpAPI_FUNC(jobject) JcpPyObject_AsJPyObject(JNIEnv *, PyObject *);
 
@@ -15,8 +15,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_BigDecimal = 0;
-static jmethodID toString = 0;
+static Jcp_ATOMIC jmethodID init_BigDecimal = 0;
+static Jcp_ATOMIC jmethodID toString = 0;
 
 jobject JavaBigDecimal_New(JNIEnv* env, jstring value) {
   if (!init_BigDecimal) {
@@ -15,8 +15,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_Z = 0;
-static jmethodID booleanValue = 0;
+static Jcp_ATOMIC jmethodID init_Z = 0;
+static Jcp_ATOMIC jmethodID booleanValue = 0;
 
 jobject JavaBoolean_New(JNIEnv* env, jboolean jval) {
   if (!init_Z) {
@@ -15,7 +15,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_B = 0;
+static Jcp_ATOMIC jmethodID init_B = 0;
 
 jobject JavaByte_New(JNIEnv* env, jbyte jval) {
   if (!init_B) {
@@ -15,8 +15,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_C = 0;
-static jmethodID charValue = 0;
+static Jcp_ATOMIC jmethodID init_C = 0;
+static Jcp_ATOMIC jmethodID charValue = 0;
 
 jobject JavaCharacter_New(JNIEnv* env, jchar jval) {
   if (!init_C) {
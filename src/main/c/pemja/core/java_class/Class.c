@@ -15,12 +15,12 @@
 
 #include "Pemja.h"
 
-static jmethodID getName = 0;
-static jmethodID getConstructors = 0;
-static jmethodID getMethods = 0;
-static jmethodID getFields = 0;
-static jmethodID getComponentType = 0;
-static jmethodID isArray = 0;
+static Jcp_ATOMIC jmethodID getName = 0;
+static Jcp_ATOMIC jmethodID getConstructors = 0;
+static Jcp_ATOMIC jmethodID getMethods = 0;
+static Jcp_ATOMIC jmethodID getFields = 0;
+static Jcp_ATOMIC jmethodID getComponentType = 0;
+static Jcp_ATOMIC jmethodID isArray = 0;
 
 jstring JavaClass_getName(JNIEnv* env, jobject this) {
   if (!getName) {
@@ -0,0 +1,63 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "java_class/ClassUtils.h"
+
+#include "Pemja.h"
+
+static Jcp_ATOMIC jmethodID findClass = 0;
+static Jcp_ATOMIC jmethodID getMethods = 0;
+static Jcp_ATOMIC jmethodID getField = 0;
+static Jcp_ATOMIC jmethodID isNoGilRelease = 0;
+
+jclass JavaClassUtils_findClass(JNIEnv* env, jstring name) {
+  if (!findClass) {
+    findClass = (*env)->GetStaticMethodID(
+        env, JCLASS_UTILS_TYPE, "findClass",
+        "(Ljava/lang/String;)Ljava/lang/Class;");
+  }
+  return (jclass)(*env)->CallStaticObjectMethod(env, JCLASS_UTILS_TYPE,
+                                                findClass, name);
+}
+
+jobjectArray JavaClassUtils_getMethods(JNIEnv* env, jclass clazz,
+                                       jstring name) {
+  if (!getMethods) {
+    getMethods = (*env)->GetStaticMethodID(
+        env, JCLASS_UTILS_TYPE, "getMethods",
+        "(Ljava/lang/Class;Ljava/lang/String;)[Ljava/lang/reflect/Method;");
+  }
+  return (jobjectArray)(*env)->CallStaticObjectMethod(
+      env, JCLASS_UTILS_TYPE, getMethods, clazz, name);
+}
+
+jobject JavaClassUtils_getField(JNIEnv* env, jclass clazz, jstring name) {
+  if (!getField) {
+    getField = (*env)->GetStaticMethodID(
+        env, JCLASS_UTILS_TYPE, "getField",
+        "(Ljava/lang/Class;Ljava/lang/String;)Ljava/lang/reflect/Field;");
+  }
+  return (*env)->CallStaticObjectMethod(env, JCLASS_UTILS_TYPE, getField,
+                                        clazz, name);
+}
+
+jboolean JavaClassUtils_isNoGilRelease(JNIEnv* env, jobject method) {
+  if (!isNoGilRelease) {
+    isNoGilRelease =
+        (*env)->GetStaticMethodID(env, JCLASS_UTILS_TYPE, "isNoGilRelease",
+                                  "(Ljava/lang/reflect/Method;)Z");
+  }
+  return (*env)->CallStaticBooleanMethod(env, JCLASS_UTILS_TYPE,
+                                         isNoGilRelease, method);
+}
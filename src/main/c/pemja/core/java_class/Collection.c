@@ -14,8 +14,8 @@
 
 #include "Pemja.h"
 
-static jmethodID size = 0;
-static jmethodID contains = 0;
+static Jcp_ATOMIC jmethodID size = 0;
+static Jcp_ATOMIC jmethodID contains = 0;
 
 jint JavaCollection_size(JNIEnv* env, jobject object) {
   if (!size) {
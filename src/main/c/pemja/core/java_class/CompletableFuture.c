@@ -0,0 +1,49 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "java_class/CompletableFuture.h"
+
+#include "Pemja.h"
+
+static Jcp_ATOMIC jmethodID complete = 0;
+static Jcp_ATOMIC jmethodID completeExceptionally = 0;
+static Jcp_ATOMIC jmethodID cancel = 0;
+
+jboolean JavaCompletableFuture_complete(JNIEnv* env, jobject this,
+                                        jobject value) {
+  if (!complete) {
+    complete = (*env)->GetMethodID(env, JCOMPLETABLE_FUTURE_TYPE, "complete",
+                                   "(Ljava/lang/Object;)Z");
+  }
+  return (*env)->CallBooleanMethod(env, this, complete, value);
+}
+
+jboolean JavaCompletableFuture_completeExceptionally(JNIEnv* env, jobject this,
+                                                     jthrowable error) {
+  if (!completeExceptionally) {
+    completeExceptionally = (*env)->GetMethodID(env, JCOMPLETABLE_FUTURE_TYPE,
+                                                "completeExceptionally",
+                                                "(Ljava/lang/Throwable;)Z");
+  }
+  return (*env)->CallBooleanMethod(env, this, completeExceptionally, error);
+}
+
+jboolean JavaCompletableFuture_cancel(JNIEnv* env, jobject this,
+                                      jboolean mayInterruptIfRunning) {
+  if (!cancel) {
+    cancel =
+        (*env)->GetMethodID(env, JCOMPLETABLE_FUTURE_TYPE, "cancel", "(Z)Z");
+  }
+  return (*env)->CallBooleanMethod(env, this, cancel, mayInterruptIfRunning);
+}
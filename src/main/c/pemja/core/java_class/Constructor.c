@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID getParameterTypes = 0;
+static Jcp_ATOMIC jmethodID getParameterTypes = 0;
 
 jobjectArray JavaConstructor_getParameterTypes(JNIEnv* env, jobject this) {
   if (!getParameterTypes) {
@@ -16,10 +16,10 @@
 
 #include "Pemja.h"
 
-static jmethodID init_Date = 0;
-static jmethodID getYear = 0;
-static jmethodID getMonth = 0;
-static jmethodID getDate = 0;
+static Jcp_ATOMIC jmethodID init_Date = 0;
+static Jcp_ATOMIC jmethodID getYear = 0;
+static Jcp_ATOMIC jmethodID getMonth = 0;
+static Jcp_ATOMIC jmethodID getDate = 0;
 
 jobject JavaSqlDate_New(JNIEnv* env, jint year, jint month, jint day) {
   if (!init_Date) {
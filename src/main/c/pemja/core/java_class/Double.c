@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_D = 0;
+static Jcp_ATOMIC jmethodID init_D = 0;
 
 jobject JavaDouble_New(JNIEnv* env, jdouble jval) {
   if (!init_D) {
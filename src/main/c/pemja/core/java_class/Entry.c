@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID getKey = 0;
-static jmethodID getValue = 0;
+static Jcp_ATOMIC jmethodID getKey = 0;
+static Jcp_ATOMIC jmethodID getValue = 0;
 
 jobject JavaMapEntry_getKey(JNIEnv* env, jobject jval) {
   if (!getKey) {
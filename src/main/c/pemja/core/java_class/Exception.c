@@ -16,7 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_PythonException = 0;
+static Jcp_ATOMIC jmethodID init_PythonException = 0;
+static Jcp_ATOMIC jmethodID init_PythonTimeoutException = 0;
 
 jobject JavaPythonException_New(JNIEnv* env, jstring jmg) {
   if (!init_PythonException) {
@@ -25,3 +26,12 @@ jobject JavaPythonException_New(JNIEnv* env, jstring jmg) {
   }
   return (*env)->NewObject(env, JPYTHONEXCE_TYPE, init_PythonException, jmg);
 }
+
+jobject JavaPythonTimeoutException_New(JNIEnv* env, jstring jmg) {
+  if (!init_PythonTimeoutException) {
+    init_PythonTimeoutException = (*env)->GetMethodID(
+        env, JPYTIMEOUTEXCE_TYPE, "<init>", "(Ljava/lang/String;)V");
+  }
+  return (*env)->NewObject(env, JPYTIMEOUTEXCE_TYPE,
+                           init_PythonTimeoutException, jmg);
+}
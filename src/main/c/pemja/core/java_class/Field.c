@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID getType = 0;
-static jmethodID getModifiers = 0;
+static Jcp_ATOMIC jmethodID getType = 0;
+static Jcp_ATOMIC jmethodID getModifiers = 0;
 
 jclass JavaField_getType(JNIEnv* env, jobject this) {
   if (!getType) {
@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_F = 0;
+static Jcp_ATOMIC jmethodID init_F = 0;
 
 jobject JavaFloat_New(JNIEnv* env, jfloat jval) {
   if (!init_F) {
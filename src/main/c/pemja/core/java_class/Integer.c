@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_I = 0;
+static Jcp_ATOMIC jmethodID init_I = 0;
 
 jobject JavaInteger_New(JNIEnv* env, jint jval) {
   if (!init_I) {
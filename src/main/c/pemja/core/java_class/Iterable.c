@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID iterator = 0;
+static Jcp_ATOMIC jmethodID iterator = 0;
 
 jobject JavaIterable_iterator(JNIEnv* env, jobject jval) {
   if (!iterator) {
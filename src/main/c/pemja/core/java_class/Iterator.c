@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID hasNext = 0;
-static jmethodID next = 0;
+static Jcp_ATOMIC jmethodID hasNext = 0;
+static Jcp_ATOMIC jmethodID next = 0;
 
 jboolean JavaIterator_hasNext(JNIEnv* env, jobject jval) {
   if (!hasNext) {
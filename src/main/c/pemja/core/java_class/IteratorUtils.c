@@ -0,0 +1,31 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "java_class/IteratorUtils.h"
+
+#include "Pemja.h"
+
+static Jcp_ATOMIC jmethodID nextChunk = 0;
+
+jobjectArray JavaIteratorUtils_nextChunk(JNIEnv* env, jobject iterator,
+                                         jint size) {
+  if (!nextChunk) {
+    nextChunk = (*env)->GetStaticMethodID(
+        env, JITERATOR_UTILS_TYPE, "nextChunk",
+        "(Ljava/util/Iterator;I)[Ljava/lang/Object;");
+  }
+  return (jobjectArray)(*env)->CallStaticObjectMethod(
+      env, JITERATOR_UTILS_TYPE, nextChunk, iterator, size);
+}
@@ -16,13 +16,13 @@
 
 #include "Pemja.h"
 
-static jmethodID init_ArrayList = 0;
-static jmethodID init_ArrayList_with_capacity = 0;
-static jmethodID init_ArrayList_with_collection = 0;
-static jmethodID add = 0;
-static jmethodID addAll = 0;
-static jmethodID get = 0;
-static jmethodID set = 0;
+static Jcp_ATOMIC jmethodID init_ArrayList = 0;
+static Jcp_ATOMIC jmethodID init_ArrayList_with_capacity = 0;
+static Jcp_ATOMIC jmethodID init_ArrayList_with_collection = 0;
+static Jcp_ATOMIC jmethodID add = 0;
+static Jcp_ATOMIC jmethodID addAll = 0;
+static Jcp_ATOMIC jmethodID get = 0;
+static Jcp_ATOMIC jmethodID set = 0;
 
 jobject JavaList_NewArrayList(JNIEnv* env) {
   if (!init_ArrayList) {
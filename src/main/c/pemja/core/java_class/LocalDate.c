@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID ofEpochDay = 0;
-static jmethodID toEpochDay = 0;
+static Jcp_ATOMIC jmethodID ofEpochDay = 0;
+static Jcp_ATOMIC jmethodID toEpochDay = 0;
 
 jobject JavaLocalDate_ofEpochDay(JNIEnv* env, jlong epochDay) {
   if (!ofEpochDay) {
@@ -16,9 +16,9 @@
 
 #include "Pemja.h"
 
-static jmethodID of = 0;
-static jmethodID toLocalDate = 0;
-static jmethodID toLocalTime = 0;
+static Jcp_ATOMIC jmethodID of = 0;
+static Jcp_ATOMIC jmethodID toLocalDate = 0;
+static Jcp_ATOMIC jmethodID toLocalTime = 0;
 
 jobject JavaLocalDateTime_of(JNIEnv* env, jobject date, jobject time) {
   if (!of) {
@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID ofNanoOfDay = 0;
-static jmethodID toNanoOfDay = 0;
+static Jcp_ATOMIC jmethodID ofNanoOfDay = 0;
+static Jcp_ATOMIC jmethodID toNanoOfDay = 0;
 
 jobject JavaLocalTime_ofNanoOfDay(JNIEnv* env, jlong nanoOfDay) {
   if (!ofNanoOfDay) {
@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_J = 0;
+static Jcp_ATOMIC jmethodID init_J = 0;
 
 jobject JavaLong_New(JNIEnv* env, jlong jval) {
   if (!init_J) {
@@ -16,15 +16,15 @@
 
 #include "Pemja.h"
 
-static jmethodID init_HashMap = 0;
-static jmethodID entrySet = 0;
-static jmethodID put = 0;
-static jmethodID get = 0;
-static jmethodID remove_key = 0;
-static jmethodID contains_key = 0;
-static jmethodID size = 0;
-static jmethodID key_set = 0;
-static jmethodID values = 0;
+static Jcp_ATOMIC jmethodID init_HashMap = 0;
+static Jcp_ATOMIC jmethodID entrySet = 0;
+static Jcp_ATOMIC jmethodID put = 0;
+static Jcp_ATOMIC jmethodID get = 0;
+static Jcp_ATOMIC jmethodID remove_key = 0;
+static Jcp_ATOMIC jmethodID contains_key = 0;
+static Jcp_ATOMIC jmethodID size = 0;
+static Jcp_ATOMIC jmethodID key_set = 0;
+static Jcp_ATOMIC jmethodID values = 0;
 
 jobject JavaMap_NewHashMap(JNIEnv* env) {
   if (!init_HashMap) {
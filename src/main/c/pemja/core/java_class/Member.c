@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID getName = 0;
+static Jcp_ATOMIC jmethodID getName = 0;
 
 jobject JavaMember_getName(JNIEnv* env, jobject this) {
   if (!getName) {
@@ -16,10 +16,10 @@
 
 #include "Pemja.h"
 
-static jmethodID getParameterTypes = 0;
-static jmethodID getModifiers = 0;
-static jmethodID getReturnType = 0;
-static jmethodID isVarArgs = 0;
+static Jcp_ATOMIC jmethodID getParameterTypes = 0;
+static Jcp_ATOMIC jmethodID getModifiers = 0;
+static Jcp_ATOMIC jmethodID getReturnType = 0;
+static Jcp_ATOMIC jmethodID isVarArgs = 0;
 
 jobjectArray JavaMethod_getParameterTypes(JNIEnv* env, jobject this) {
   if (!getParameterTypes) {
@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID isStatic = 0;
+static Jcp_ATOMIC jmethodID isStatic = 0;
 
 jboolean JavaModifier_isStatic(JNIEnv* env, jint mod) {
   if (!isStatic) {
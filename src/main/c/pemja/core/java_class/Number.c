@@ -16,12 +16,12 @@
 
 #include "Pemja.h"
 
-static jmethodID byteValue = 0;
-static jmethodID shortValue = 0;
-static jmethodID intValue = 0;
-static jmethodID longValue = 0;
-static jmethodID floatValue = 0;
-static jmethodID doubleValue = 0;
+static Jcp_ATOMIC jmethodID byteValue = 0;
+static Jcp_ATOMIC jmethodID shortValue = 0;
+static Jcp_ATOMIC jmethodID intValue = 0;
+static Jcp_ATOMIC jmethodID longValue = 0;
+static Jcp_ATOMIC jmethodID floatValue = 0;
+static Jcp_ATOMIC jmethodID doubleValue = 0;
 
 jbyte JavaNumber_byteValue(JNIEnv* env, jobject jval) {
   if (!byteValue) {
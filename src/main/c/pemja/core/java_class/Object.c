@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID equals = 0;
-static jmethodID toString = 0;
+static Jcp_ATOMIC jmethodID equals = 0;
+static Jcp_ATOMIC jmethodID toString = 0;
 
 jboolean JavaObject_equals(JNIEnv* env, jobject this, jobject other) {
   if (!equals) {
@@ -0,0 +1,142 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "java_class/PyDict.h"
+
+#include "Pemja.h"
+
+static Jcp_ATOMIC jmethodID init_PyDict = 0;
+
+jobject JavaPyDict_New(JNIEnv *env, jlong tstate, jlong pyobject) {
+  if (!init_PyDict) {
+    init_PyDict = (*env)->GetMethodID(env, JPYDICT_TYPE, "<init>", "(JJ)V");
+  }
+  return (*env)->NewObject(env, JPYDICT_TYPE, init_PyDict, tstate, pyobject);
+}
+
+JNIEXPORT jint JNICALL Java_pemja_core_object_PyDict_size(JNIEnv *env,
+                                                          jobject this,
+                                                          jlong ptr,
+                                                          jlong ptr_obj) {
+  Py_ssize_t size;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      size = PyMapping_Size((PyObject *)ptr_obj);
+
+  if (size < 0) {
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return (jint)size;
+}
+
+JNIEXPORT jobject JNICALL Java_pemja_core_object_PyDict_get(JNIEnv *env,
+                                                            jobject this,
+                                                            jlong ptr,
+                                                            jlong ptr_obj,
+                                                            jobject key) {
+  PyObject *pykey, *pyvalue = NULL;
+
+  jobject result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      pykey = JcpPyObject_FromJObject(env, key);
+
+  if (pykey) {
+    pyvalue = PyObject_GetItem((PyObject *)ptr_obj, pykey);
+    Py_DECREF(pykey);
+  }
+
+  if (pyvalue) {
+    result = JcpPyObject_AsJObject(env, pyvalue, JOBJECT_TYPE);
+    Py_DECREF(pyvalue);
+  } else if (PyErr_ExceptionMatches(PyExc_KeyError)) {
+    // Map.get returns null for missing keys.
+    PyErr_Clear();
+  }
+
+  JcpPyErr_Throw(env);
+
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
+
+JNIEXPORT jboolean JNICALL Java_pemja_core_object_PyDict_containsKey(
+    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj, jobject key) {
+  int result = 0;
+
+  PyObject *pykey;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      pykey = JcpPyObject_FromJObject(env, key);
+
+  if (pykey) {
+    result = PySequence_Contains((PyObject *)ptr_obj, pykey);
+    Py_DECREF(pykey);
+  }
+
+  if (result < 0) {
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result > 0 ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_pemja_core_object_PyDict_items(
+    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj) {
+  Py_ssize_t size;
+  PyObject *items, *item;
+
+  jobject element;
+  jobjectArray result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      items = PyMapping_Items((PyObject *)ptr_obj);
+
+  if (items == NULL) {
+    JcpPyErr_Throw(env);
+  } else {
+    size = PyList_GET_SIZE(items);
+    result = (*env)->NewObjectArray(env, (jsize)(size * 2), JOBJECT_TYPE, NULL);
+
+    for (Py_ssize_t i = 0; i < size * 2; i++) {
+      item = PyTuple_GET_ITEM(PyList_GET_ITEM(items, i / 2), i % 2);
+      element = JcpPyObject_AsJObject(env, item, JOBJECT_TYPE);
+
+      if (PyErr_Occurred()) {
+        JcpPyErr_Throw(env);
+        result = NULL;
+        break;
+      }
+
+      (*env)->SetObjectArrayElement(env, result, (jsize)i, element);
+      (*env)->DeleteLocalRef(env, element);
+    }
+
+    Py_DECREF(items);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
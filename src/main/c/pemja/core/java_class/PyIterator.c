@@ -16,7 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_PyIterator = 0;
+static Jcp_ATOMIC jmethodID init_PyIterator = 0;
+static Jcp_ATOMIC jfieldID pendingError = 0;
 
 jobject JavaPyIterator_New(JNIEnv *env, jlong tstate, jlong pyobject) {
   if (!init_PyIterator) {
@@ -27,32 +28,82 @@ jobject JavaPyIterator_New(JNIEnv *env, jlong tstate, jlong pyobject) {
                            pyobject);
 }
 
-JNIEXPORT jobject JNICALL Java_pemja_core_object_PyIterator_next(
-    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj) {
-  PyObject *pyobject, *item;
+JNIEXPORT jobjectArray JNICALL Java_pemja_core_object_PyIterator_nextChunk(
+    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj, jint size) {
+  int length = 0;
 
-  jobject result = NULL;
+  PyObject *pyobject;
+  PyObject **items;
+
+  jobject element;
+  jthrowable error;
+  jobjectArray result = NULL;
 
   Jcp_BEGIN_ALLOW_THREADS
 
       pyobject = (PyObject *)ptr_obj;
 
-  item = PyIter_Next(pyobject);
+  items = PyMem_Malloc(sizeof(PyObject *) * size);
+
+  if (items == NULL) {
+    PyErr_NoMemory();
+    JcpPyErr_Throw(env);
+    goto exit;
+  }
+
+  // Fetches up to `size` elements with the GIL held once. Less elements than
+  // requested means the end of the Python iterator has been reached.
+  while (length < size) {
+    items[length] = PyIter_Next(pyobject);
+
+    if (items[length] == NULL) {
+      break;
+    }
+
+    length++;
+  }
 
   if (PyErr_Occurred()) {
     JcpPyErr_Throw(env);
-    Py_XDECREF(item);
-  } else {
-    if (item) {
-      result = JcpPyObject_AsJObject(env, item, JOBJECT_TYPE);
-      Py_DECREF(item);
-    } else {
-      // last value;
-      (*env)->ThrowNew(env, JNOSUCHELEMENT_EXEC_TYPE, "StopIteration");
+    if (length == 0) {
+      goto exit;
+    }
+
+    // the fetched elements have been consumed from the Python iterator, so
+    // they are returned and the error is thrown once they are consumed
+    error = (*env)->ExceptionOccurred(env);
+    (*env)->ExceptionClear(env);
+    if (!pendingError) {
+      pendingError = (*env)->GetFieldID(env, JPYITERPRETER_TYPE, "pendingError",
+                                        "Ljava/lang/Throwable;");
+    }
+    (*env)->SetObjectField(env, this, pendingError, error);
+    (*env)->DeleteLocalRef(env, error);
+  }
+
+  result = (*env)->NewObjectArray(env, length, JOBJECT_TYPE, NULL);
+
+  for (int i = 0; i < length; i++) {
+    element = JcpPyObject_AsJObject(env, items[i], JOBJECT_TYPE);
+
+    if (PyErr_Occurred()) {
+      JcpPyErr_Throw(env);
+      (*env)->DeleteLocalRef(env, result);
+      result = NULL;
+      break;
     }
+
+    (*env)->SetObjectArrayElement(env, result, i, element);
+    (*env)->DeleteLocalRef(env, element);
   }
 
+exit:
+  for (int i = 0; i < length; i++) {
+    Py_DECREF(items[i]);
+  }
+  PyMem_Free(items);
+
   Jcp_END_ALLOW_THREADS
 
       return result;
-}
\ No newline at end of file
+}
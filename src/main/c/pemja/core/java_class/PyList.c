@@ -0,0 +1,148 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "java_class/PyList.h"
+
+#include "Pemja.h"
+
+static Jcp_ATOMIC jmethodID init_PyList = 0;
+
+jobject JavaPyList_New(JNIEnv *env, jlong tstate, jlong pyobject) {
+  if (!init_PyList) {
+    init_PyList = (*env)->GetMethodID(env, JPYLIST_TYPE, "<init>", "(JJ)V");
+  }
+  return (*env)->NewObject(env, JPYLIST_TYPE, init_PyList, tstate, pyobject);
+}
+
+JNIEXPORT jint JNICALL Java_pemja_core_object_PyList_size(JNIEnv *env,
+                                                          jobject this,
+                                                          jlong ptr,
+                                                          jlong ptr_obj) {
+  Py_ssize_t size;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      size = PySequence_Size((PyObject *)ptr_obj);
+
+  if (size < 0) {
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return (jint)size;
+}
+
+JNIEXPORT jobject JNICALL Java_pemja_core_object_PyList_get(JNIEnv *env,
+                                                            jobject this,
+                                                            jlong ptr,
+                                                            jlong ptr_obj,
+                                                            jint index) {
+  char *msg;
+  PyObject *pyobject, *item;
+
+  jobject result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      pyobject = (PyObject *)ptr_obj;
+
+  // Python accepts negative indexes, while Java List doesn't.
+  if (index < 0 || index >= PySequence_Size(pyobject)) {
+    msg = malloc(sizeof(char) * 200);
+    memset(msg, '\0', 200);
+    sprintf(msg, "Index: %d, Size: %zd", index, PySequence_Size(pyobject));
+
+    (*env)->ThrowNew(env, JINDEX_OUT_OF_BOUNDS_EXEC_TYPE, msg);
+
+    free(msg);
+  } else {
+    item = PySequence_GetItem(pyobject, index);
+
+    if (item) {
+      result = JcpPyObject_AsJObject(env, item, JOBJECT_TYPE);
+      Py_DECREF(item);
+    }
+
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
+
+JNIEXPORT jboolean JNICALL Java_pemja_core_object_PyList_contains(
+    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj, jobject o) {
+  int result = 0;
+
+  PyObject *pyvalue;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      pyvalue = JcpPyObject_FromJObject(env, o);
+
+  if (pyvalue) {
+    result = PySequence_Contains((PyObject *)ptr_obj, pyvalue);
+    Py_DECREF(pyvalue);
+  }
+
+  if (result < 0) {
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result > 0 ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_pemja_core_object_PyList_toArray(
+    JNIEnv *env, jobject this, jlong ptr, jlong ptr_obj) {
+  Py_ssize_t size;
+  PyObject *pyobject;
+
+  jobject element;
+  jobjectArray result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      pyobject = PySequence_Fast((PyObject *)ptr_obj, "expected a sequence");
+
+  if (pyobject == NULL) {
+    JcpPyErr_Throw(env);
+  } else {
+    size = PySequence_Fast_GET_SIZE(pyobject);
+    result = (*env)->NewObjectArray(env, (jsize)size, JOBJECT_TYPE, NULL);
+
+    for (Py_ssize_t i = 0; i < size; i++) {
+      element = JcpPyObject_AsJObject(
+          env, PySequence_Fast_GET_ITEM(pyobject, i), JOBJECT_TYPE);
+
+      if (PyErr_Occurred()) {
+        JcpPyErr_Throw(env);
+        result = NULL;
+        break;
+      }
+
+      (*env)->SetObjectArrayElement(env, result, (jsize)i, element);
+      (*env)->DeleteLocalRef(env, element);
+    }
+
+    Py_DECREF(pyobject);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
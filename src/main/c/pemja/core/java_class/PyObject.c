@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_PyObject = 0;
-static jfieldID field_pyobject = 0;
+static Jcp_ATOMIC jmethodID init_PyObject = 0;
+static Jcp_ATOMIC jfieldID field_pyobject = 0;
 
 jobject JavaPyObject_New(JNIEnv* env, jlong tstate, jlong pyobject) {
   if (!init_PyObject) {
@@ -234,3 +234,70 @@ JNIEXPORT jobject JNICALL Java_pemja_core_object_PyObject_invokeMethod(
 
       return result;
 }
+
+/* The max number of arguments passed to a Python callable without allocation */
+#define JCP_CALL_STACK_ARGS 8
+
+JNIEXPORT jobject JNICALL Java_pemja_core_object_PyObject_call(
+    JNIEnv* env, jobject this, jlong ptr, jlong ptr_obj, jobjectArray args,
+    jclass return_type) {
+  PyObject* callable;
+  PyObject* stack_args[JCP_CALL_STACK_ARGS];
+  PyObject** py_args = stack_args;
+  PyObject* py_ret = NULL;
+  int arg_len, converted = 0;
+
+  jobject element;
+  jobject result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      callable = (PyObject*)ptr_obj;
+  arg_len = args ? (*env)->GetArrayLength(env, args) : 0;
+
+  if (arg_len > JCP_CALL_STACK_ARGS) {
+    py_args = (PyObject**)PyMem_Malloc(sizeof(PyObject*) * arg_len);
+    if (!py_args) {
+      PyErr_NoMemory();
+    }
+  }
+
+  if (callable && py_args) {
+    for (; converted < arg_len; converted++) {
+      element = (*env)->GetObjectArrayElement(env, args, converted);
+      py_args[converted] = JcpPyObject_FromJObject(env, element);
+      (*env)->DeleteLocalRef(env, element);
+      if (!py_args[converted]) {
+        break;
+      }
+    }
+
+    if (converted == arg_len) {
+#if PY_MINOR_VERSION >= 9
+      py_ret = PyObject_Vectorcall(callable, py_args, arg_len, NULL);
+#else
+      py_ret = _PyObject_Vectorcall(callable, py_args, arg_len, NULL);
+#endif
+    }
+
+    for (int i = 0; i < converted; i++) {
+      Py_DECREF(py_args[i]);
+    }
+  }
+
+  if (py_args && py_args != stack_args) {
+    PyMem_Free(py_args);
+  }
+
+  if (!JcpPyErr_Throw(env)) {
+    // the result of a void method is discarded
+    if (py_ret && return_type) {
+      result = JcpPyObject_AsJObject(env, py_ret, return_type);
+    }
+    Py_XDECREF(py_ret);
+  }
+
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
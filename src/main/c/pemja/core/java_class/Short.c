@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_S = 0;
+static Jcp_ATOMIC jmethodID init_S = 0;
 
 jobject JavaShort_New(JNIEnv* env, jshort jval) {
   if (!init_S) {
@@ -16,7 +16,7 @@
 
 #include "Pemja.h"
 
-static jmethodID init_StackTraceElement = 0;
+static Jcp_ATOMIC jmethodID init_StackTraceElement = 0;
 
 jobject JavaStackTraceElement_New(JNIEnv* env, jstring declaringClass,
                                   jstring methodName, jstring fileName,
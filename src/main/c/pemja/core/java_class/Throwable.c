@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID getStackTrace = 0;
-static jmethodID setStackTrace = 0;
+static Jcp_ATOMIC jmethodID getStackTrace = 0;
+static Jcp_ATOMIC jmethodID setStackTrace = 0;
 
 jobjectArray JavaThrowable_getStackTrace(JNIEnv* env, jobject this) {
   if (!getStackTrace) {
@@ -16,8 +16,8 @@
 
 #include "Pemja.h"
 
-static jmethodID init_time = 0;
-static jmethodID getTime = 0;
+static Jcp_ATOMIC jmethodID init_time = 0;
+static Jcp_ATOMIC jmethodID getTime = 0;
 
 jobject JavaSqlTime_New(JNIEnv* env, jlong jval) {
   if (!init_time) {
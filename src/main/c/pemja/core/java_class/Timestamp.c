@@ -16,16 +16,16 @@
 
 #include "Pemja.h"
 
-static jmethodID init_Timestamp = 0;
-static jmethodID valueOf = 0;
-static jmethodID toLocalDateTime = 0;
-static jmethodID getYear = 0;
-static jmethodID getMonth = 0;
-static jmethodID getDate = 0;
-static jmethodID getHours = 0;
-static jmethodID getMinutes = 0;
-static jmethodID getSeconds = 0;
-static jmethodID getNanos = 0;
+static Jcp_ATOMIC jmethodID init_Timestamp = 0;
+static Jcp_ATOMIC jmethodID valueOf = 0;
+static Jcp_ATOMIC jmethodID toLocalDateTime = 0;
+static Jcp_ATOMIC jmethodID getYear = 0;
+static Jcp_ATOMIC jmethodID getMonth = 0;
+static Jcp_ATOMIC jmethodID getDate = 0;
+static Jcp_ATOMIC jmethodID getHours = 0;
+static Jcp_ATOMIC jmethodID getMinutes = 0;
+static Jcp_ATOMIC jmethodID getSeconds = 0;
+static Jcp_ATOMIC jmethodID getNanos = 0;
 
 jobject JavaSqlTimestamp_New(JNIEnv* env, jint year, jint month, jint day,
                              jint hour, jint minute, jint second, jint nano) {
@@ -25,6 +25,7 @@ int JcpPyErr_Throw(JNIEnv *env) {
   PyObject *extract_method;
   PyObject *pymsg = NULL;
   PyObject *pystack = NULL;
+  int timeout = 0;
 
   jobject jpyexception = NULL;
 
@@ -35,6 +36,10 @@ int JcpPyErr_Throw(JNIEnv *env) {
   PyErr_Fetch(&type, &value, &traceback);
 
   if (type) {
+    // the calls interrupted by Java raise the PythonTimeoutError of _pemja
+    timeout = PyErr_GivenExceptionMatches(
+        type, JcpModuleState_Get()->timeout_error);
+
     // get the message of exception.
     if (PyObject_TypeCheck(value, (PyTypeObject *)PyExc_BaseException)) {
       args = PyObject_GetAttrString(value, "args");
@@ -56,8 +61,13 @@ int JcpPyErr_Throw(JNIEnv *env) {
       Py_DECREF(value_str);
     }
 
-    jpyexception =
-        JavaPythonException_New(env, JcpPyString_AsJString(env, pymsg));
+    if (timeout) {
+      jpyexception = JavaPythonTimeoutException_New(
+          env, JcpPyString_AsJString(env, pymsg));
+    } else {
+      jpyexception =
+          JavaPythonException_New(env, JcpPyString_AsJString(env, pymsg));
+    }
 
     if (traceback) {
       traceback_module = PyImport_ImportModule("traceback");
@@ -13,10 +13,39 @@
 // limitations under the License.
 
 #include "Pemja.h"
+#include "java_class/JavaClass.h"
 #include "python_class/PythonClass.h"
 
 static PyThreadState *JcpMainThreadState = NULL;
 
+/* The methods, fields and Python types of Java classes shared by all the
+ * threads of the Main Interpreter */
+static PyObject *JcpMainClassCache = NULL;
+
+/* The number of JcpThreads of the Main Interpreter, the cache of Java classes
+ * is cleared once the last of them is finalized */
+static int JcpMainThreads = 0;
+
+/* The namespaces in which the warm-up codes of the threads of the Main
+ * Interpreter have run, keyed by the codes */
+static PyObject *JcpMainTemplates = NULL;
+
+/* The JcpThreads of the sub interpreters kept idle by Java, which are detached
+ * from any thread and guarded by their lock */
+static JcpThread *JcpDetachedThreads = NULL;
+static PyThread_type_lock JcpDetachedThreadsLock = NULL;
+
+#ifdef Py_GIL_DISABLED
+/* Serializes the lookups, the updates and the clearing of the cache of Java
+ * classes, which the GIL does in the other builds. */
+static PyMutex JcpClassCacheMutex = {0};
+#define JcpClassCache_LOCK() PyMutex_Lock(&JcpClassCacheMutex)
+#define JcpClassCache_UNLOCK() PyMutex_Unlock(&JcpClassCacheMutex)
+#else
+#define JcpClassCache_LOCK()
+#define JcpClassCache_UNLOCK()
+#endif
+
 /*
  * Create redirection module.
  */
@@ -51,32 +80,45 @@ static PyMethodDef redirectionMethods[] = {
     {NULL, NULL, 0, NULL} /*sentinel */
 };
 
+static PyModuleDef_Slot redirection_slots[] = {
+#ifdef Py_mod_multiple_interpreters
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL} /*sentinel */
+};
+
 static struct PyModuleDef redirection_module_def = {
     PyModuleDef_HEAD_INIT,
     "redirection",      /* m_name */
     NULL,               /* m_doc */
-    -1,                 /* m_size */
+    0,                  /* m_size */
     redirectionMethods, /* m_methods */
-    NULL,               /* m_reload */
+    redirection_slots,  /* m_slots */
     NULL,               /* m_traverse */
     NULL,               /* m_clear */
     NULL,               /* m_free */
 };
 
+static PyObject *redirection_module_create(void) {
+  return PyModuleDef_Init(&redirection_module_def);
+}
+
 /*
  * Create pemja module.
  */
 
 static PyObject *pemja_find_class(PyObject *self, PyObject *args) {
   JcpThread *jcp_thread;
-  PyObject *result;
-
-  char *name, *p;
+  PyObject *name, *result, *cached;
 
   JNIEnv *env;
+  jstring jname;
   jclass clazz;
 
-  if (!PyArg_ParseTuple(args, "s", &name)) {
+  if (!PyArg_ParseTuple(args, "U", &name)) {
     return NULL;
   }
 
@@ -89,418 +131,1425 @@ static PyObject *pemja_find_class(PyObject *self, PyObject *args) {
     return NULL;
   }
 
-  // get JNIEnv*
-  env = jcp_thread->env;
+  // the found classes are kept per JcpThread, as the classes of the same name
+  // may be loaded by the class loaders of different PythonInterpreters
+  result = PyDict_GetItem(jcp_thread->name_to_class, name);
+  if (result) {
+    Py_INCREF(result);
+    return result;
+  }
 
-  // convert python class name to java class name. e.g. java.lang.Object ->
-  // java/lang/Object
-  for (p = name; *p != '\0'; p++) {
-    if (*p == '.') {
-      *p = '/';
-    }
+  // get JNIEnv*, the thread of the event loop is bound to the JcpThread too
+  if (PyThreadState_Get() == jcp_thread->tstate) {
+    env = jcp_thread->env;
+  } else {
+    env = JcpThreadEnv_Get();
+  }
+
+  jname = JcpPyString_AsJString(env, name);
+  if (!jname) {
+    return NULL;
   }
 
-  clazz = (*env)->FindClass(env, name);
+  clazz = JavaClassUtils_findClass(env, jname);
+  (*env)->DeleteLocalRef(env, jname);
   // failed to find the class
-  if ((*env)->ExceptionOccurred(env)) {
+  if (JcpJavaErr_Throw(env)) {
     return NULL;
   }
 
   result = JcpPyJClass_New(env, clazz);
-
   (*env)->DeleteLocalRef(env, clazz);
+  if (!result) {
+    return NULL;
+  }
+
+  // keeps the class found by another thread meanwhile, if any
+  cached = PyDict_SetDefault(jcp_thread->name_to_class, name, result);
+  Py_XINCREF(cached);
+  Py_DECREF(result);
+  return cached;
+}
+
+static PyObject *pemja_fields(PyObject *self, PyObject *args) {
+  PyObject *obj, *names, *reader, *result;
+
+  if (!PyArg_ParseTuple(args, "OO", &obj, &names)) {
+    return NULL;
+  }
+
+  // the fields are cached by the class, so the reader is cheap to create
+  reader = PyObject_CallFunctionObjArgs((PyObject *)&PyJFieldReader_Type, obj,
+                                        names, NULL);
+  if (!reader) {
+    return NULL;
+  }
+
+  result = PyObject_CallFunctionObjArgs(reader, obj, NULL);
+  Py_DECREF(reader);
   return result;
 }
 
-static PyMethodDef pemja_methods[] = {
-    {"findClass", (PyCFunction)pemja_find_class, METH_VARARGS, ""},
-    {NULL, NULL, 0, NULL} /*sentinel */
-};
+static PyObject *pemja_map_call(PyObject *self, PyObject *args) {
+  PyObject *method, *iterable;
 
-static struct PyModuleDef pemja_module_def = {
-    PyModuleDef_HEAD_INIT,
-    "_pemja",      /* m_name */
-    NULL,          /* m_doc */
-    -1,            /* m_size */
-    pemja_methods, /* m_methods */
-    NULL,          /* m_reload */
-    NULL,          /* m_traverse */
-    NULL,          /* m_clear */
-    NULL,          /* m_free */
-};
+  if (!PyArg_ParseTuple(args, "OO", &method, &iterable)) {
+    return NULL;
+  }
 
-/*
- * Initialize pemja module
- */
-static PyObject *pemja_module_init(JNIEnv *env) {
-  PyObject *sys_modules = NULL;
-  PyObject *pemja_module = NULL;
+  return JcpPyJMethod_Map(method, iterable, 0);
+}
 
-  // create _pemja module
-  pemja_module = PyModule_Create(&pemja_module_def);
-  if (pemja_module == NULL) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to create `_pemja` module.");
+static PyObject *pemja_starmap_call(PyObject *self, PyObject *args) {
+  PyObject *method, *iterable;
+
+  if (!PyArg_ParseTuple(args, "OO", &method, &iterable)) {
     return NULL;
   }
 
-  sys_modules = PyImport_GetModuleDict();
-  if (PyDict_SetItemString(sys_modules, "_pemja", pemja_module) == -1) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to add `_pemja` module to sys.modules");
+  return JcpPyJMethod_Map(method, iterable, 1);
+}
+
+/* Run the event loop of the asynchronous calls in the thread started by
+ * pemja.event_loop, which is bound to the JcpThread of the calls. */
+
+static PyObject *pemja_run_event_loop(PyObject *self, PyObject *args) {
+  PyObject *loop, *capsule, *tdict, *key, *result;
+
+  if (!PyArg_ParseTuple(args, "OO!", &loop, &PyCapsule_Type, &capsule)) {
     return NULL;
   }
 
-  // import _pemja module
-  pemja_module = PyImport_ImportModule("_pemja");
-  if (!pemja_module) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to import `_pemja` module");
+  if ((tdict = PyThreadState_GetDict()) == NULL) {
+    PyErr_Format(PyExc_RuntimeError, "Failed to get the thread dict.");
     return NULL;
   }
 
-  // stuff for making new pyjarray objects
-  PyModule_AddIntConstant(pemja_module, "JBOOLEAN_ID", JBOOLEAN_ID);
-  PyModule_AddIntConstant(pemja_module, "JINT_ID", JINT_ID);
-  PyModule_AddIntConstant(pemja_module, "JLONG_ID", JLONG_ID);
-  PyModule_AddIntConstant(pemja_module, "JSTRING_ID", JSTRING_ID);
-  PyModule_AddIntConstant(pemja_module, "JDOUBLE_ID", JDOUBLE_ID);
-  PyModule_AddIntConstant(pemja_module, "JSHORT_ID", JSHORT_ID);
-  PyModule_AddIntConstant(pemja_module, "JFLOAT_ID", JFLOAT_ID);
-  PyModule_AddIntConstant(pemja_module, "JCHAR_ID", JCHAR_ID);
-  PyModule_AddIntConstant(pemja_module, "JBYTE_ID", JBYTE_ID);
+  key = PyUnicode_FromString(DICT_KEY);
+  if (key == NULL || PyDict_SetItem(tdict, key, capsule) < 0) {
+    Py_XDECREF(key);
+    return NULL;
+  }
 
-  return pemja_module;
+  result = PyObject_CallMethod(loop, "run_forever", NULL);
+
+  if (PyDict_DelItem(tdict, key) < 0 && result != NULL) {
+    Py_CLEAR(result);
+  }
+  Py_DECREF(key);
+
+  // the thread has been attached to the JVM by the completed futures, which
+  // would otherwise leak its Java thread once the thread exits
+  Py_BEGIN_ALLOW_THREADS
+  JcpThreadEnv_Detach();
+  Py_END_ALLOW_THREADS
+
+  return result;
 }
 
-/**
- * Get the JcpThread.
- */
-JcpThread *JcpThread_Get(void) {
-  PyObject *tdict, *t, *key;
-  JcpThread *ret = NULL;
+/* Complete the Java future with the PythonException of the current error. */
 
-  key = PyUnicode_FromString(DICT_KEY);
-  if ((tdict = PyThreadState_GetDict()) != NULL && key != NULL) {
-    t = PyDict_GetItem(tdict, key); /* borrowed */
-    if (t != NULL && !PyErr_Occurred()) {
-      ret = (JcpThread *)PyCapsule_GetPointer(t, NULL);
-    }
-  }
-  Py_XDECREF(key);
-  if (!ret && !PyErr_Occurred()) {
-    PyErr_Format(PyExc_RuntimeError,
-                 "No JcpThread instance available on current thread.");
+static void jcp_complete_exceptionally(JNIEnv *env, jobject future) {
+  jthrowable error;
+
+  JcpPyErr_Throw(env);
+  error = (*env)->ExceptionOccurred(env);
+  (*env)->ExceptionClear(env);
+
+  if (error != NULL) {
+    JavaCompletableFuture_completeExceptionally(env, future, error);
+    (*env)->DeleteLocalRef(env, error);
   }
-  return ret;
 }
 
-JNIEnv *JcpThreadEnv_Get(void) {
-  JavaVM *jvm;
+/* Complete the Java future with the concurrent.futures.Future of a coroutine
+ * run by the event loop of the asynchronous calls, which calls it once the
+ * coroutine is done. */
+
+static PyObject *pemja_complete_future(PyObject *self, PyObject *args) {
+  PyObject *jfuture, *future, *cancelled, *exception, *result;
+  int is_cancelled;
+
   JNIEnv *env;
-  jsize nVMs;
+  jobject jresult;
 
-  JNI_GetCreatedJavaVMs(&jvm, 1, &nVMs);
+  if (!PyArg_ParseTuple(args, "O!O", &PyJObject_Type, &jfuture, &future)) {
+    return NULL;
+  }
 
-  (*jvm)->AttachCurrentThreadAsDaemon(jvm, (void **)&env, NULL);
+  env = JcpThreadEnv_Get();
 
-  return env;
+  cancelled = PyObject_CallMethod(future, "cancelled", NULL);
+  if (cancelled == NULL) {
+    return NULL;
+  }
+  is_cancelled = PyObject_IsTrue(cancelled);
+  Py_DECREF(cancelled);
+
+  if (is_cancelled) {
+    JavaCompletableFuture_cancel(env, ((PyJObject *)jfuture)->object,
+                                 JNI_FALSE);
+  } else {
+    exception = PyObject_CallMethod(future, "exception", NULL);
+    if (exception == NULL) {
+      return NULL;
+    }
+
+    if (exception != Py_None) {
+      // thrown as the error of the coroutine with its traceback
+      Py_INCREF(Py_TYPE(exception));
+      PyErr_Restore((PyObject *)Py_TYPE(exception), exception,
+                    PyException_GetTraceback(exception));
+      jcp_complete_exceptionally(env, ((PyJObject *)jfuture)->object);
+    } else {
+      Py_DECREF(exception);
+      result = PyObject_CallMethod(future, "result", NULL);
+      if (result == NULL) {
+        return NULL;
+      }
+
+      jresult = JcpPyObject_AsJObject(env, result, JOBJECT_TYPE);
+      Py_DECREF(result);
+      if (PyErr_Occurred()) {
+        jcp_complete_exceptionally(env, ((PyJObject *)jfuture)->object);
+      } else {
+        JavaCompletableFuture_complete(env, ((PyJObject *)jfuture)->object,
+                                       jresult);
+      }
+      if (jresult != NULL) {
+        (*env)->DeleteLocalRef(env, jresult);
+      }
+    }
+  }
+
+  if (JcpJavaErr_Throw(env)) {
+    return NULL;
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
 }
 
-/*
- * Initialize Python main Interpreter and this method will be called at startup
- * and be called only once.
- */
+static PyMethodDef pemja_methods[] = {
+    {"findClass", (PyCFunction)pemja_find_class, METH_VARARGS, ""},
+    {"fields", (PyCFunction)pemja_fields, METH_VARARGS, ""},
+    {"map_call", (PyCFunction)pemja_map_call, METH_VARARGS, ""},
+    {"starmap_call", (PyCFunction)pemja_starmap_call, METH_VARARGS, ""},
+    {"run_event_loop", (PyCFunction)pemja_run_event_loop, METH_VARARGS, ""},
+    {"complete_future", (PyCFunction)pemja_complete_future, METH_VARARGS, ""},
+    {NULL, NULL, 0, NULL} /*sentinel */
+};
+
+/* Create a type of the module, which instantiates it only if the spec has a
+ * Py_tp_new slot like the static types used to */
+static int pemja_type_add(PyObject *module, PyTypeObject **type,
+                          PyType_Spec *spec, PyTypeObject *base) {
+  PyType_Slot *slot;
+  PyObject *result;
 
-static int pyjtypes_init() {
-  if (PyType_Ready(&PyJObject_Type) < 0) {
+#if PY_MINOR_VERSION >= 9
+  result = PyType_FromModuleAndSpec(module, spec, (PyObject *)base);
+#else
+  result = PyType_FromSpecWithBases(spec, (PyObject *)base);
+#endif
+  if (!result) {
     return -1;
   }
+  *type = (PyTypeObject *)result;
 
-  // class
-  if (!PyJClass_Type.tp_base) {
-    PyJClass_Type.tp_base = &PyJObject_Type;
+  for (slot = spec->slots; slot->slot; slot++) {
+    if (slot->slot == Py_tp_new) {
+      return 0;
+    }
   }
+  (*type)->tp_new = NULL;
+  return 0;
+}
+
+static int pemja_module_exec(PyObject *module) {
+  JcpModuleState *state;
 
-  if (PyType_Ready(&PyJClass_Type) < 0) {
+  state = (JcpModuleState *)PyModule_GetState(module);
+
+  if (pemja_type_add(module, &state->pyjobject_type, &PyJObject_Spec, NULL) <
+      0) {
     return -1;
   }
 
-  // iterable
-  if (!PyJIterable_Type.tp_base) {
-    PyJIterable_Type.tp_base = &PyJObject_Type;
+  // class
+  if (pemja_type_add(module, &state->pyjclass_type, &PyJClass_Spec,
+                     state->pyjobject_type) < 0) {
+    return -1;
   }
 
-  if (PyType_Ready(&PyJIterable_Type) < 0) {
+  // iterable
+  if (pemja_type_add(module, &state->pyjiterable_type, &PyJIterable_Spec,
+                     state->pyjobject_type) < 0) {
     return -1;
   }
 
   // iterator
-  if (!PyJIterator_Type.tp_base) {
-    PyJIterator_Type.tp_base = &PyJObject_Type;
+  if (pemja_type_add(module, &state->pyjiterator_type, &PyJIterator_Spec,
+                     state->pyjobject_type) < 0) {
+    return -1;
   }
 
-  if (PyType_Ready(&PyJIterator_Type) < 0) {
+  // buffered iterator
+  if (pemja_type_add(module, &state->pyjbufferediterator_type,
+                     &PyJBufferedIterator_Spec, state->pyjiterator_type) < 0) {
     return -1;
   }
 
   // collection
-  if (!PyJCollection_Type.tp_base) {
-    PyJCollection_Type.tp_base = &PyJIterable_Type;
+  if (pemja_type_add(module, &state->pyjcollection_type, &PyJCollection_Spec,
+                     state->pyjiterable_type) < 0) {
+    return -1;
   }
 
-  if (PyType_Ready(&PyJCollection_Type) < 0) {
+  // list
+  if (pemja_type_add(module, &state->pyjlist_type, &PyJList_Spec,
+                     state->pyjcollection_type) < 0) {
     return -1;
   }
 
-  // list
-  if (!PyJList_Type.tp_base) {
-    PyJList_Type.tp_base = &PyJCollection_Type;
+  // dict
+  if (pemja_type_add(module, &state->pyjdict_type, &PyJDict_Spec,
+                     state->pyjobject_type) < 0) {
+    return -1;
   }
 
-  if (PyType_Ready(&PyJList_Type) < 0) {
+  // batched field access
+  if (pemja_type_add(module, &state->pyjfieldreader_type,
+                     &PyJFieldReader_Spec, NULL) < 0) {
     return -1;
   }
 
-  // dict
-  if (!PyJDict_Type.tp_base) {
-    PyJDict_Type.tp_base = &PyJObject_Type;
+  if (pemja_type_add(module, &state->pyjfieldwriter_type,
+                     &PyJFieldWriter_Spec, NULL) < 0) {
+    return -1;
   }
 
-  if (PyType_Ready(&PyJDict_Type) < 0) {
+  // members
+  if (pemja_type_add(module, &state->pyjmethod_type, &PyJMethod_Spec, NULL) <
+      0) {
     return -1;
   }
 
-  return 0;
-}
+  if (pemja_type_add(module, &state->pyjconstructor_type,
+                     &PyJConstructor_Spec, state->pyjmethod_type) < 0) {
+    return -1;
+  }
 
-void JcpPy_setPythonHome(JNIEnv *env, jstring home) {
-  const char *home_as_utf = (*env)->GetStringUTFChars(env, home, NULL);
-  wchar_t *home_for_python = Py_DecodeLocale(home_as_utf, NULL);
-  (*env)->ReleaseStringUTFChars(env, home, home_as_utf);
-  Py_SetPythonHome(home_for_python);
-}
+  if (pemja_type_add(module, &state->pyjmultimethod_type,
+                     &PyJMultiMethod_Spec, NULL) < 0) {
+    return -1;
+  }
 
-void JcpPy_Initialize(JNIEnv *env, jstring python_home, jstring working_dir) {
-  PyObject *sys_modules = NULL;
-  PyObject *redirection_module = NULL;
+  if (pemja_type_add(module, &state->pyjfield_type, &PyJField_Spec, NULL) <
+      0) {
+    return -1;
+  }
 
-  if (JcpMainThreadState != NULL) {
-    // this shouldn't happen but to be safe, don't initialize twice
-    return;
+  // the exception raised in the calls interrupted by Java, which isn't an
+  // Exception, so that it isn't swallowed by `except Exception`
+  state->timeout_error = PyErr_NewException("_pemja.PythonTimeoutError",
+                                            PyExc_BaseException, NULL);
+  if (!state->timeout_error) {
+    return -1;
   }
 
-  // Cache java classes
-  Jcp_CacheClasses(env);
+  // stuff for making new pyjarray objects
+  if (PyModule_AddIntConstant(module, "JBOOLEAN_ID", JBOOLEAN_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JINT_ID", JINT_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JLONG_ID", JLONG_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JSTRING_ID", JSTRING_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JDOUBLE_ID", JDOUBLE_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JSHORT_ID", JSHORT_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JFLOAT_ID", JFLOAT_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JCHAR_ID", JCHAR_ID) < 0 ||
+      PyModule_AddIntConstant(module, "JBYTE_ID", JBYTE_ID) < 0) {
+    return -1;
+  }
 
-  // Initialize Python
-  Py_Initialize();
+  // batched reads and writes of the fields of Java objects
+  Py_INCREF(state->pyjfieldreader_type);
+  if (PyModule_AddObject(module, "FieldReader",
+                         (PyObject *)state->pyjfieldreader_type) < 0) {
+    Py_DECREF(state->pyjfieldreader_type);
+    return -1;
+  }
 
-#if PY_MINOR_VERSION < 9
-  // Initialize Python thread support
-  PyEval_InitThreads();
-#endif
+  Py_INCREF(state->pyjfieldwriter_type);
+  if (PyModule_AddObject(module, "FieldWriter",
+                         (PyObject *)state->pyjfieldwriter_type) < 0) {
+    Py_DECREF(state->pyjfieldwriter_type);
+    return -1;
+  }
 
-  if (pyjtypes_init() < 0) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to initialize pyjtypes.");
-    return;
+  Py_INCREF(state->timeout_error);
+  if (PyModule_AddObject(module, "PythonTimeoutError", state->timeout_error) <
+      0) {
+    Py_DECREF(state->timeout_error);
+    return -1;
   }
 
-  // save a pointer to the main PyThreadState object
-  JcpMainThreadState = PyThreadState_Get();
+  return 0;
+}
 
-  // create redirection module
-  redirection_module = PyModule_Create(&redirection_module_def);
-  if (redirection_module == NULL) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to create `redirection` module.");
-    goto EXIT;
-  }
+static int pemja_module_traverse(PyObject *module, visitproc visit,
+                                 void *arg) {
+  JcpModuleState *state = (JcpModuleState *)PyModule_GetState(module);
+
+  Py_VISIT(state->pyjobject_type);
+  Py_VISIT(state->pyjclass_type);
+  Py_VISIT(state->pyjiterable_type);
+  Py_VISIT(state->pyjiterator_type);
+  Py_VISIT(state->pyjbufferediterator_type);
+  Py_VISIT(state->pyjcollection_type);
+  Py_VISIT(state->pyjlist_type);
+  Py_VISIT(state->pyjdict_type);
+  Py_VISIT(state->pyjfieldreader_type);
+  Py_VISIT(state->pyjfieldwriter_type);
+  Py_VISIT(state->pyjmethod_type);
+  Py_VISIT(state->pyjconstructor_type);
+  Py_VISIT(state->pyjmultimethod_type);
+  Py_VISIT(state->pyjfield_type);
+  Py_VISIT(state->timeout_error);
+  return 0;
+}
 
-  sys_modules = PyImport_GetModuleDict();
-  if (PyDict_SetItemString(sys_modules, "redirection", redirection_module) ==
-      -1) {
-    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to add `redirection` module to sys.modules");
-    goto EXIT;
-  }
+static int pemja_module_clear(PyObject *module) {
+  JcpModuleState *state = (JcpModuleState *)PyModule_GetState(module);
+
+  Py_CLEAR(state->pyjobject_type);
+  Py_CLEAR(state->pyjclass_type);
+  Py_CLEAR(state->pyjiterable_type);
+  Py_CLEAR(state->pyjiterator_type);
+  Py_CLEAR(state->pyjbufferediterator_type);
+  Py_CLEAR(state->pyjcollection_type);
+  Py_CLEAR(state->pyjlist_type);
+  Py_CLEAR(state->pyjdict_type);
+  Py_CLEAR(state->pyjfieldreader_type);
+  Py_CLEAR(state->pyjfieldwriter_type);
+  Py_CLEAR(state->pyjmethod_type);
+  Py_CLEAR(state->pyjconstructor_type);
+  Py_CLEAR(state->pyjmultimethod_type);
+  Py_CLEAR(state->pyjfield_type);
+  Py_CLEAR(state->timeout_error);
+  return 0;
+}
 
-  // import redirection module
-  redirection_module = PyImport_ImportModule("redirection");
-  if (!redirection_module) {
+static void pemja_module_free(void *module) {
+  pemja_module_clear((PyObject *)module);
+}
+
+static PyModuleDef_Slot pemja_slots[] = {
+    {Py_mod_exec, (void *)pemja_module_exec},
+#ifdef Py_mod_multiple_interpreters
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL} /*sentinel */
+};
+
+/* Every interpreter creates its own _pemja module with the types of pemja */
+static struct PyModuleDef pemja_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "_pemja",               /* m_name */
+    NULL,                   /* m_doc */
+    sizeof(JcpModuleState), /* m_size */
+    pemja_methods,          /* m_methods */
+    pemja_slots,            /* m_slots */
+    pemja_module_traverse,  /* m_traverse */
+    pemja_module_clear,     /* m_clear */
+    pemja_module_free,      /* m_free */
+};
+
+static PyObject *pemja_module_create(void) {
+  return PyModuleDef_Init(&pemja_module_def);
+}
+
+/*
+ * Initialize pemja module
+ */
+static PyObject *pemja_module_init(JNIEnv *env) {
+  PyObject *pemja_module;
+
+  // the module is created once per interpreter and shared by its threads
+  pemja_module = PyImport_ImportModule("_pemja");
+  if (!pemja_module) {
     (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
-                     "Failed to import `redirection` module");
-    goto EXIT;
+                     "Failed to import `_pemja` module");
+    return NULL;
   }
-  Py_DECREF(redirection_module);
 
-  // set sys.argv
-  wchar_t *argv[] = {L"jcp", 0};
+  return pemja_module;
+}
 
-  PySys_SetArgv(1, argv);
+/* The state of the _pemja module of the interpreter the current thread runs,
+ * which is remembered per thread until the thread switches interpreters */
+static Jcp_THREAD_LOCAL int64_t jcp_state_interp_id = -1;
+static Jcp_THREAD_LOCAL JcpModuleState *jcp_state = NULL;
 
-  if (python_home) {
-    const char *python_home_chars =
-        (*env)->GetStringUTFChars(env, python_home, NULL);
-    Py_SetPythonHome(Py_DecodeLocale(python_home_chars, NULL));
-    (*env)->ReleaseStringUTFChars(env, python_home, python_home_chars);
+JcpModuleState *JcpModuleState_Get(void) {
+  PyObject *type, *value, *traceback;
+  PyObject *pemja_module;
+  int64_t interp_id;
+
+  interp_id = PyInterpreterState_GetID(PyThreadState_Get()->interp);
+  if (interp_id == jcp_state_interp_id) {
+    return jcp_state;
   }
 
-  if (working_dir) {
-    const char *working_dir_chars =
-        (*env)->GetStringUTFChars(env, working_dir, NULL);
-    chdir(working_dir_chars);
-    (*env)->ReleaseStringUTFChars(env, working_dir, working_dir_chars);
+  // the types are looked up with an exception set, e.g. by JcpPyErr_Throw
+  PyErr_Fetch(&type, &value, &traceback);
+  pemja_module = PyImport_ImportModule("_pemja");
+  if (!pemja_module) {
+    Py_FatalError("Failed to import `_pemja` module");
   }
+  jcp_state = (JcpModuleState *)PyModule_GetState(pemja_module);
+  jcp_state_interp_id = interp_id;
+  // the interpreter keeps the module alive in sys.modules
+  Py_DECREF(pemja_module);
+  PyErr_Restore(type, value, traceback);
 
-EXIT:
-  PyEval_ReleaseThread(JcpMainThreadState);
+  return jcp_state;
+}
+
+/**
+ * Get the JcpThread.
+ */
+JcpThread *JcpThread_Get(void) {
+  PyObject *tdict, *t, *key;
+  JcpThread *ret = NULL;
+
+  key = PyUnicode_FromString(DICT_KEY);
+  if ((tdict = PyThreadState_GetDict()) != NULL && key != NULL) {
+    t = PyDict_GetItem(tdict, key); /* borrowed */
+    if (t != NULL && !PyErr_Occurred()) {
+      ret = (JcpThread *)PyCapsule_GetPointer(t, NULL);
+    }
+  }
+  Py_XDECREF(key);
+  if (!ret && !PyErr_Occurred()) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "No JcpThread instance available on current thread.");
+  }
+  return ret;
+}
+
+JNIEnv *JcpThreadEnv_Get(void) {
+  JavaVM *jvm;
+  JNIEnv *env;
+  jsize nVMs;
+
+  JNI_GetCreatedJavaVMs(&jvm, 1, &nVMs);
+
+  (*jvm)->AttachCurrentThreadAsDaemon(jvm, (void **)&env, NULL);
+
+  return env;
+}
+
+/* Detach the current thread from the JVM if it has been attached by
+ * JcpThreadEnv_Get, e.g. a thread created in Python which is about to exit. */
+void JcpThreadEnv_Detach(void) {
+  JavaVM *jvm;
+  JNIEnv *env;
+  jsize nVMs;
+
+  JNI_GetCreatedJavaVMs(&jvm, 1, &nVMs);
+
+  if ((*jvm)->GetEnv(jvm, (void **)&env, JNI_VERSION_1_8) == JNI_OK) {
+    (*jvm)->DetachCurrentThread(jvm);
+  }
+}
+
+/*
+ * Initialize Python main Interpreter and this method will be called at startup
+ * and be called only once.
+ */
+
+void JcpPy_setPythonHome(JNIEnv *env, jstring home) {
+  const char *home_as_utf = (*env)->GetStringUTFChars(env, home, NULL);
+  wchar_t *home_for_python = Py_DecodeLocale(home_as_utf, NULL);
+  (*env)->ReleaseStringUTFChars(env, home, home_as_utf);
+  Py_SetPythonHome(home_for_python);
+}
+
+void JcpPy_Initialize(JNIEnv *env, jstring python_home, jstring working_dir) {
+  PyObject *redirection_module = NULL;
+
+  if (JcpMainThreadState != NULL) {
+    // this shouldn't happen but to be safe, don't initialize twice
+    return;
+  }
+
+  // Cache java classes
+  Jcp_CacheClasses(env);
+
+  // the built-in modules of pemja, which every interpreter creates on import
+  PyImport_AppendInittab("redirection", redirection_module_create);
+  PyImport_AppendInittab("_pemja", pemja_module_create);
+
+  // Initialize Python
+  Py_Initialize();
+
+#if PY_MINOR_VERSION < 9
+  // Initialize Python thread support
+  PyEval_InitThreads();
+#endif
+
+  // save a pointer to the main PyThreadState object
+  JcpMainThreadState = PyThreadState_Get();
+
+  // the caches of the Main Interpreter are created upfront, so that the
+  // threads never race on creating them
+  JcpMainClassCache = PyDict_New();
+  JcpMainTemplates = PyDict_New();
+  JcpDetachedThreadsLock = PyThread_allocate_lock();
+  if (!JcpMainClassCache || !JcpMainTemplates || !JcpDetachedThreadsLock) {
+    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                     "Failed to create the caches of Java classes.");
+    goto EXIT;
+  }
+
+  // import redirection module
+  redirection_module = PyImport_ImportModule("redirection");
+  if (!redirection_module) {
+    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                     "Failed to import `redirection` module");
+    goto EXIT;
+  }
+  Py_DECREF(redirection_module);
+
+  // set sys.argv
+  wchar_t *argv[] = {L"jcp", 0};
+
+  PySys_SetArgv(1, argv);
+
+  if (python_home) {
+    const char *python_home_chars =
+        (*env)->GetStringUTFChars(env, python_home, NULL);
+    Py_SetPythonHome(Py_DecodeLocale(python_home_chars, NULL));
+    (*env)->ReleaseStringUTFChars(env, python_home, python_home_chars);
+  }
+
+  if (working_dir) {
+    const char *working_dir_chars =
+        (*env)->GetStringUTFChars(env, working_dir, NULL);
+    chdir(working_dir_chars);
+    (*env)->ReleaseStringUTFChars(env, working_dir, working_dir_chars);
+  }
+
+EXIT:
+  PyEval_ReleaseThread(JcpMainThreadState);
+}
+
+/*
+ * Finalize Python Interpreter and release resources.
+ */
+
+void JcpPy_Finalize(JavaVM *vm) {
+  JNIEnv *env;
+  JcpThread *jcp_thread;
+
+  if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_8) != JNI_OK) {
+    env = NULL;
+  }
+
+  // the idle sub interpreters can't outlive the Main Interpreter
+  if (JcpDetachedThreadsLock) {
+    PyThread_acquire_lock(JcpDetachedThreadsLock, WAIT_LOCK);
+    while ((jcp_thread = JcpDetachedThreads) != NULL) {
+      JcpDetachedThreads = jcp_thread->next_detached;
+      PyThread_release_lock(JcpDetachedThreadsLock);
+
+      JcpPy_AttachThread(env, (intptr_t)jcp_thread);
+      JcpPy_FinalizeThread((intptr_t)jcp_thread);
+
+      PyThread_acquire_lock(JcpDetachedThreadsLock, WAIT_LOCK);
+    }
+    PyThread_release_lock(JcpDetachedThreadsLock);
+  }
+
+  // shutdown python
+  PyEval_AcquireThread(JcpMainThreadState);
+  Py_CLEAR(JcpMainTemplates);
+  Py_CLEAR(JcpMainClassCache);
+  Py_Finalize();
+
+  if (env == NULL) {
+    // failed to get a JNIEnv*, we can hope it's just shutting down fast
+    return;
+  } else {
+    // delete global references
+    Jcp_UnRefCacheClasses(env);
+  }
+}
+
+/*
+ * Create a sub interpreter having its own GIL, so that it runs in parallel with
+ * the Main Interpreter and the other sub interpreters. Returns the detached
+ * PyThreadState of the sub interpreter.
+ */
+
+static PyThreadState *jcp_new_interpreter_own_gil(JNIEnv *env) {
+#if PY_MINOR_VERSION >= 12
+  PyThreadState *tstate = NULL;
+  PyStatus status;
+  PyInterpreterConfig config = {
+      .use_main_obmalloc = 0,
+      .allow_fork = 0,
+      .allow_exec = 0,
+      .allow_threads = 1,
+      .allow_daemon_threads = 0,
+      .check_multi_interp_extensions = 1,
+      .gil = PyInterpreterConfig_OWN_GIL,
+  };
+
+  PyEval_AcquireThread(JcpMainThreadState);
+
+  status = Py_NewInterpreterFromConfig(&tstate, &config);
+  if (PyStatus_Exception(status)) {
+    PyEval_ReleaseThread(JcpMainThreadState);
+    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                     status.err_msg ? status.err_msg
+                                    : "Failed to create sub interpreter.");
+    return NULL;
+  }
+
+  // the GIL of the Main Interpreter has been released by the creation
+  PyEval_SaveThread();
+
+  return tstate;
+#else
+  (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                   "SUB_INTERPRETER_OWN_GIL requires Python 3.12 or later.");
+  return NULL;
+#endif
+}
+
+/*
+ * Check that the GIL is disabled, which requires a free-threaded build of
+ * Python 3.13+. Importing extensions not supporting it enables the GIL again.
+ */
+
+static int jcp_check_free_threaded(JNIEnv *env) {
+#ifdef Py_GIL_DISABLED
+  PyObject *is_gil_enabled, *result;
+  int enabled;
+
+  PyEval_AcquireThread(JcpMainThreadState);
+
+  is_gil_enabled = PySys_GetObject("_is_gil_enabled"); /* borrowed */
+  result = is_gil_enabled ? PyObject_CallNoArgs(is_gil_enabled) : NULL;
+  enabled = result ? PyObject_IsTrue(result) : -1;
+  Py_XDECREF(result);
+  PyErr_Clear();
+
+  PyEval_ReleaseThread(JcpMainThreadState);
+
+  if (enabled != 0) {
+    (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                     "FREE_THREADED requires the GIL to be disabled.");
+    return -1;
+  }
+  return 0;
+#else
+  (*env)->ThrowNew(env, JILLEGAL_STATE_EXEC_TYPE,
+                   "FREE_THREADED requires a free-threaded build of Python.");
+  return -1;
+#endif
+}
+
+/*
+ * Initialize JcpThread and attach a new PyThreadState to it.
+ */
+
+intptr_t JcpPy_InitThread(JNIEnv *env, int type) {
+  JcpThread *jcp_thread;
+
+  PyObject *tdict, *globals = NULL, *key, *t;
+
+  jcp_thread = malloc(sizeof(JcpThread));
+  if (!jcp_thread) {
+    return 0;
+  }
+
+  if (type == JCP_EXEC_MULTI_THREAD) {
+    // create new ThreadState
+    jcp_thread->tstate = PyThreadState_New(JcpMainThreadState->interp);
+
+  } else if (type == JCP_EXEC_FREE_THREADED) {
+    // create new ThreadState running without the GIL
+    if (jcp_check_free_threaded(env) < 0) {
+      free(jcp_thread);
+      return 0;
+    }
+    jcp_thread->tstate = PyThreadState_New(JcpMainThreadState->interp);
+
+  } else if (type == JCP_EXEC_SUB_INTERPRETER) {
+    // create sub interpreter
+    PyEval_AcquireThread(JcpMainThreadState);
+
+    jcp_thread->tstate = Py_NewInterpreter();
+
+    PyEval_SaveThread();
+  } else if (type == JCP_EXEC_SUB_INTERPRETER_OWN_GIL) {
+    // create sub interpreter with its own GIL
+    jcp_thread->tstate = jcp_new_interpreter_own_gil(env);
+    if (!jcp_thread->tstate) {
+      free(jcp_thread);
+      return 0;
+    }
+  } else {
+    PyErr_Format(PyExc_RuntimeError, "Unknown exec type `%d` ", type);
+  }
+
+  PyEval_AcquireThread(jcp_thread->tstate);
+
+  if (type == JCP_EXEC_MULTI_THREAD || type == JCP_EXEC_FREE_THREADED) {
+    JcpClassCache_LOCK();
+    JcpMainThreads++;
+    JcpClassCache_UNLOCK();
+
+    globals = PyDict_New();
+    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+  } else {
+    PyObject *mod_main = PyImport_AddModule("__main__"); /* borrowed */
+    if (mod_main == NULL) {
+      PyEval_ReleaseThread(jcp_thread->tstate);
+      return 0;
+    }
+    globals = PyModule_GetDict(mod_main);
+    Py_INCREF(globals);
+  }
+
+  if ((tdict = PyThreadState_GetDict()) != NULL) {
+    // Capsule objects let you wrap a C "void *" pointer in a Python object.
+    t = PyCapsule_New((void *)jcp_thread, NULL, NULL);
+    key = PyUnicode_FromString(DICT_KEY);
+
+    PyDict_SetItem(tdict, key, t); /* takes ownership */
+
+    Py_DECREF(key);
+    Py_DECREF(t);
+  }
+
+  // Init JcpThread
+  jcp_thread->globals = globals;
+  jcp_thread->env = env;
+  jcp_thread->cache_function_name = NULL;
+  jcp_thread->cache_object_name = NULL;
+  jcp_thread->cache_method_name = NULL;
+  jcp_thread->cache_callable = NULL;
+  jcp_thread->name_to_attrs = NULL;
+  // created upfront, as the thread of the event loop shares it
+  jcp_thread->name_to_class = PyDict_New();
+  jcp_thread->conversion_policy = JCP_LAZY_PROXY;
+  jcp_thread->exec_type = type;
+  jcp_thread->in_session = 0;
+  jcp_thread->globals_snapshot = NULL;
+  jcp_thread->interp = NULL;
+  jcp_thread->interrupt_id = 0;
+  jcp_thread->event_loop = NULL;
+  jcp_thread->pemja_module = pemja_module_init(env);
+
+  PyEval_ReleaseThread(jcp_thread->tstate);
+
+  return (intptr_t)jcp_thread;
+}
+
+/* Stop the event loop of the asynchronous calls of the JcpThread, if started,
+ * which cancels the coroutines still running. */
+
+static void jcp_event_loop_stop(JcpThread *jcp_thread) {
+  PyObject *result;
+
+  if (jcp_thread->event_loop) {
+    result = PyObject_CallMethod(jcp_thread->event_loop, "stop", NULL);
+    if (result == NULL) {
+      PyErr_Print();
+    }
+    Py_XDECREF(result);
+    Py_CLEAR(jcp_thread->event_loop);
+  }
+}
+
+/* Release the Java classes cached by the Main Interpreter once its last
+ * JcpThread is finalized, so that the global references of the cache don't
+ * pin the class loaders of closed PythonInterpreters until Python is
+ * finalized. The Python objects still using the classes keep their own. */
+
+static void jcp_main_thread_exit(void) {
+  JcpClassCache_LOCK();
+  if (--JcpMainThreads == 0) {
+    PyDict_Clear(JcpMainClassCache);
+  }
+  JcpClassCache_UNLOCK();
+}
+
+/*
+ * Finalize JcpThread.
+ */
+
+void JcpPy_FinalizeThread(intptr_t ptr) {
+  JcpThread *jcp_thread;
+
+  PyObject *tdict, *key;
+
+  jcp_thread = (JcpThread *)ptr;
+  if (!jcp_thread) {
+    printf("WARNING: thread_close, invalid JcpThread pointer.\n");
+    return;
+  }
+
+  PyEval_AcquireThread(jcp_thread->tstate);
+
+  jcp_event_loop_stop(jcp_thread);
+
+  key = PyUnicode_FromString(DICT_KEY);
+  if ((tdict = PyThreadState_GetDict()) != NULL && key != NULL) {
+    PyDict_DelItem(tdict, key);
+  }
+
+  Py_DECREF(key);
+
+  Py_CLEAR(jcp_thread->globals);
+  Py_CLEAR(jcp_thread->globals_snapshot);
+  Py_CLEAR(jcp_thread->name_to_attrs);
+  Py_CLEAR(jcp_thread->name_to_class);
+  Py_CLEAR(jcp_thread->pemja_module);
+
+  if (jcp_thread->cache_function_name) {
+    free(jcp_thread->cache_function_name);
+  }
+
+  if (jcp_thread->cache_object_name) {
+    free(jcp_thread->cache_object_name);
+  }
+
+  if (jcp_thread->cache_method_name) {
+    free(jcp_thread->cache_method_name);
+  }
+
+  Py_XDECREF(jcp_thread->cache_callable);
+
+  if (jcp_thread->tstate->interp == JcpMainThreadState->interp) {
+    jcp_main_thread_exit();
+    PyThreadState_Clear(jcp_thread->tstate);
+    PyEval_ReleaseThread(jcp_thread->tstate);
+    PyThreadState_Delete(jcp_thread->tstate);
+  } else if (jcp_thread->exec_type == JCP_EXEC_SUB_INTERPRETER_OWN_GIL) {
+    // the GIL of the sub interpreter ends with it
+    Py_EndInterpreter(jcp_thread->tstate);
+  } else {
+    Py_EndInterpreter(jcp_thread->tstate);
+    PyThreadState_Swap(JcpMainThreadState);
+    PyEval_ReleaseThread(JcpMainThreadState);
+  }
+
+  free(jcp_thread);
+}
+
+/* Set the policy of converting Java collections to Python objects */
+
+void JcpPy_SetConversionPolicy(intptr_t ptr, int policy) {
+  JcpThread *jcp_thread;
+
+  jcp_thread = (JcpThread *)ptr;
+  jcp_thread->conversion_policy = policy;
+}
+
+/* Attach the PyThreadState of the JcpThread until the session ends, so that
+ * the calls in the session don't acquire it again. */
+
+void JcpPy_BeginSession(intptr_t ptr) {
+  JcpThread *jcp_thread;
+
+  jcp_thread = (JcpThread *)ptr;
+  PyEval_AcquireThread(jcp_thread->tstate);
+  jcp_thread->in_session = 1;
+}
+
+/* Detach the PyThreadState of the JcpThread held by the session. */
+
+void JcpPy_EndSession(intptr_t ptr) {
+  JcpThread *jcp_thread;
+
+  jcp_thread = (JcpThread *)ptr;
+  jcp_thread->in_session = 0;
+  PyEval_ReleaseThread(jcp_thread->tstate);
+}
+
+/* Save a shallow copy of the globals of the JcpThread, e.g. after its modules
+ * have been imported, which is restored when the JcpThread is recycled. */
+
+int JcpPy_SaveGlobals(intptr_t ptr) {
+  JcpThread *jcp_thread;
+  PyObject *snapshot;
+
+  jcp_thread = (JcpThread *)ptr;
+  PyEval_AcquireThread(jcp_thread->tstate);
+
+  snapshot = PyDict_Copy(jcp_thread->globals);
+  if (!snapshot) {
+    PyErr_Clear();
+  }
+  Py_XDECREF(jcp_thread->globals_snapshot);
+  jcp_thread->globals_snapshot = snapshot;
+
+  PyEval_ReleaseThread(jcp_thread->tstate);
+
+  return snapshot ? 0 : -1;
+}
+
+/* Restore the globals of the JcpThread to the saved copy and clear the cached
+ * callable, so that the JcpThread can be used by another PythonInterpreter.
+ * The modules imported meanwhile are kept in sys.modules. */
+
+int JcpPy_RestoreGlobals(intptr_t ptr) {
+  JcpThread *jcp_thread;
+  int ret = -1;
+
+  jcp_thread = (JcpThread *)ptr;
+  PyEval_AcquireThread(jcp_thread->tstate);
+
+  jcp_event_loop_stop(jcp_thread);
+  _clear_jcp_cache(jcp_thread);
+  jcp_thread->cache_callable = NULL;
+  // the next PythonInterpreter may use other class loaders
+  Py_CLEAR(jcp_thread->name_to_attrs);
+  PyDict_Clear(jcp_thread->name_to_class);
+
+  if (jcp_thread->globals_snapshot) {
+    PyDict_Clear(jcp_thread->globals);
+    ret = PyDict_Update(jcp_thread->globals, jcp_thread->globals_snapshot);
+    if (ret < 0) {
+      PyErr_Clear();
+    }
+  }
+
+  PyEval_ReleaseThread(jcp_thread->tstate);
+
+  return ret;
+}
+
+/*
+ * Delete the PyThreadState of the JcpThread of a sub interpreter in the thread
+ * owning it, so that the idle sub interpreter has no PyThreadState bound to a
+ * thread until the JcpThread is attached to another thread. The detached
+ * JcpThreads left are finalized with the Main Interpreter.
+ */
+
+void JcpPy_DetachThread(intptr_t ptr) {
+  JcpThread *jcp_thread;
+
+  jcp_thread = (JcpThread *)ptr;
+  jcp_thread->interp = jcp_thread->tstate->interp;
+
+  // the PyThreadState is deleted while it is current, which releases the GIL
+  PyEval_AcquireThread(jcp_thread->tstate);
+  PyThreadState_Clear(jcp_thread->tstate);
+  PyThreadState_DeleteCurrent();
+
+  jcp_thread->tstate = NULL;
+
+  PyThread_acquire_lock(JcpDetachedThreadsLock, WAIT_LOCK);
+  jcp_thread->next_detached = JcpDetachedThreads;
+  JcpDetachedThreads = jcp_thread;
+  PyThread_release_lock(JcpDetachedThreadsLock);
+}
+
+/*
+ * Attach the JcpThread detached by JcpPy_DetachThread to the current thread
+ * with a new PyThreadState of its sub interpreter.
+ */
+
+void JcpPy_AttachThread(JNIEnv *env, intptr_t ptr) {
+  JcpThread *jcp_thread;
+
+  JcpThread **detached;
+
+  PyObject *tdict, *key, *t;
+
+  jcp_thread = (JcpThread *)ptr;
+
+  PyThread_acquire_lock(JcpDetachedThreadsLock, WAIT_LOCK);
+  for (detached = &JcpDetachedThreads; *detached;
+       detached = &(*detached)->next_detached) {
+    if (*detached == jcp_thread) {
+      *detached = jcp_thread->next_detached;
+      break;
+    }
+  }
+  PyThread_release_lock(JcpDetachedThreadsLock);
+
+  jcp_thread->tstate = PyThreadState_New(jcp_thread->interp);
+  jcp_thread->env = env;
+
+  PyEval_AcquireThread(jcp_thread->tstate);
+
+  if ((tdict = PyThreadState_GetDict()) != NULL) {
+    t = PyCapsule_New((void *)jcp_thread, NULL, NULL);
+    key = PyUnicode_FromString(DICT_KEY);
+
+    PyDict_SetItem(tdict, key, t);
+
+    Py_DECREF(key);
+    Py_DECREF(t);
+  }
+
+  PyEval_ReleaseThread(jcp_thread->tstate);
+}
+
+/* The interrupt id of a JcpThread is only read and written with an attached
+ * PyThreadState, which doesn't serialize them without the GIL. */
+#ifdef Py_GIL_DISABLED
+#define Jcp_BEGIN_INTERRUPT_SECTION(jcp_thread) \
+  Py_BEGIN_CRITICAL_SECTION((jcp_thread)->pemja_module)
+#define Jcp_END_INTERRUPT_SECTION Py_END_CRITICAL_SECTION()
+#else
+#define Jcp_BEGIN_INTERRUPT_SECTION(jcp_thread) {
+#define Jcp_END_INTERRUPT_SECTION }
+#endif
+
+/* Check whether PyThreadState_SetAsyncExc raises in the PyThreadState of the
+ * JcpThread. It raises in the first PyThreadState of the interpreter created
+ * on the thread, which is another one if another JcpThread of the interpreter,
+ * e.g. of a MULTI_THREAD interpreter, has been created on the same thread
+ * later. The PyThreadStates are only deleted with the GIL held. */
+
+static int jcp_interrupt_target(JcpThread *jcp_thread) {
+  PyThreadState *tstate;
+
+  tstate = PyInterpreterState_ThreadHead(jcp_thread->tstate->interp);
+  for (; tstate != NULL; tstate = PyThreadState_Next(tstate)) {
+    if (tstate->thread_id == jcp_thread->tstate->thread_id) {
+      return tstate == jcp_thread->tstate;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Raise the PythonTimeoutError of the pemja module in the JcpThread once it
+ * runs Python code, e.g. the Python function currently invoked, which is called
+ * by any thread other than the JcpThread. The id 0 always interrupts the
+ * JcpThread, any other id only interrupts the call armed with it. The
+ * JcpThread isn't interrupted if the exception would be raised in another
+ * JcpThread of the same thread.
+ */
+
+void JcpPy_Interrupt(intptr_t ptr, jlong id) {
+  JcpThread *jcp_thread;
+  PyThreadState *saved, *tstate;
+  PyObject *timeout_error;
+
+  jcp_thread = (JcpThread *)ptr;
+
+  // the calling thread may hold the PyThreadState of a session
+  saved = JcpThreadState_Current();
+  if (saved != NULL) {
+    PyEval_SaveThread();
+  }
+
+  // a temporary PyThreadState of the interpreter of the JcpThread
+  tstate = PyThreadState_New(jcp_thread->tstate->interp);
+  PyEval_AcquireThread(tstate);
+
+  timeout_error =
+      PyObject_GetAttrString(jcp_thread->pemja_module, "PythonTimeoutError");
+  if (timeout_error != NULL) {
+    Jcp_BEGIN_INTERRUPT_SECTION(jcp_thread)
+    if ((id == 0 || id == jcp_thread->interrupt_id) &&
+        jcp_interrupt_target(jcp_thread)) {
+      PyThreadState_SetAsyncExc(jcp_thread->tstate->thread_id, timeout_error);
+    }
+    Jcp_END_INTERRUPT_SECTION
+    Py_DECREF(timeout_error);
+  }
+  PyErr_Clear();
+
+  PyThreadState_Clear(tstate);
+  PyThreadState_DeleteCurrent();
+
+  if (saved != NULL) {
+    PyEval_RestoreThread(saved);
+  }
+}
+
+/* Arm the call of the id to be interrupted by JcpPy_Interrupt and return the
+ * id of the enclosing armed call, e.g. of a Java method called from Python.
+ * The call is rejected if it couldn't be interrupted, see
+ * jcp_interrupt_target. */
+
+jlong JcpPy_ArmInterrupt(intptr_t ptr, jlong id) {
+  jlong enclosing = 0;
+
+  Jcp_BEGIN_ALLOW_THREADS
+  if (jcp_interrupt_target(jcp_thread)) {
+    Jcp_BEGIN_INTERRUPT_SECTION(jcp_thread)
+    enclosing = jcp_thread->interrupt_id;
+    jcp_thread->interrupt_id = id;
+    Jcp_END_INTERRUPT_SECTION
+  } else {
+    (*jcp_thread->env)
+        ->ThrowNew(jcp_thread->env, JILLEGAL_STATE_EXEC_TYPE,
+                   "The call can't be interrupted by its deadline while "
+                   "another interpreter created later on this thread is "
+                   "open.");
+  }
+  Jcp_END_ALLOW_THREADS
+
+  return enclosing;
+}
+
+/* Disarm the armed call once it returns, and drop its interrupt if it hasn't
+ * been raised, so that it doesn't interrupt the next call. The pending
+ * exception of another JcpThread of the same thread is left alone. */
+
+void JcpPy_DisarmInterrupt(intptr_t ptr, jlong enclosing) {
+  Jcp_BEGIN_ALLOW_THREADS
+  Jcp_BEGIN_INTERRUPT_SECTION(jcp_thread)
+  jcp_thread->interrupt_id = enclosing;
+  if (jcp_interrupt_target(jcp_thread)) {
+    PyThreadState_SetAsyncExc(jcp_thread->tstate->thread_id, NULL);
+  }
+  Jcp_END_INTERRUPT_SECTION
+  Jcp_END_ALLOW_THREADS
 }
 
 /*
- * Finalize Python Interpreter and release resources.
+ * The methods, fields and Python type of a Java class are cached by class
+ * identity rather than by class name, so that classes of the same name loaded
+ * by different class loaders never share them. Every cache maps the class name
+ * to a list of [class, attrs, type] entries, which usually contains a single
+ * entry.
+ *
+ * The threads of the Main Interpreter share a process-wide cache guarded by the
+ * GIL of the Main Interpreter, which lives as long as any of them. Python
+ * objects can't be shared across interpreters, so every sub interpreter keeps
+ * a projection of its own until it is finalized or recycled.
  */
 
-void JcpPy_Finalize(JavaVM *vm) {
-  JNIEnv *env;
+#define JCP_CLASS_ENTRY_CLASS 0
+#define JCP_CLASS_ENTRY_ATTRS 1
+#define JCP_CLASS_ENTRY_TYPE 2
 
-  // shutdown python
-  PyEval_AcquireThread(JcpMainThreadState);
-  Py_Finalize();
+static void jcp_class_capsule_destructor(PyObject *capsule) {
+  JNIEnv *env;
 
-  if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_8) != JNI_OK) {
-    // failed to get a JNIEnv*, we can hope it's just shutting down fast
-    return;
-  } else {
-    // delete global references
-    Jcp_UnRefCacheClasses(env);
-  }
+  env = JcpThreadEnv_Get();
+  (*env)->DeleteGlobalRef(env, (jclass)PyCapsule_GetPointer(capsule, NULL));
 }
 
-/*
- * Initialize JcpThread and attach a new PyThreadState to it.
- */
-
-intptr_t JcpPy_InitThread(JNIEnv *env, int type) {
+static PyObject **jcp_class_cache(void) {
   JcpThread *jcp_thread;
 
-  PyObject *tdict, *globals = NULL, *key, *t;
+  if (PyThreadState_Get()->interp == JcpMainThreadState->interp) {
+    return &JcpMainClassCache;
+  }
 
-  jcp_thread = malloc(sizeof(JcpThread));
+  jcp_thread = JcpThread_Get();
   if (!jcp_thread) {
-    return 0;
+    // a thread created in Python, the classes just won't be cached
+    PyErr_Clear();
+    return NULL;
   }
 
-  if (type == 0) {
-    // create new ThreadState
-    jcp_thread->tstate = PyThreadState_New(JcpMainThreadState->interp);
+  return &jcp_thread->name_to_attrs;
+}
 
-  } else if (type == 1) {
-    // create sub interpreter
-    PyEval_AcquireThread(JcpMainThreadState);
+/* Finds the cache entry of a Java class in the entries of its name. Returns a
+ * borrowed reference, or NULL if the class isn't cached. */
 
-    jcp_thread->tstate = Py_NewInterpreter();
+static PyObject *jcp_class_cache_find(JNIEnv *env, PyObject *entries,
+                                      jclass clazz) {
+  PyObject *entry, *capsule;
+  jclass cached_class;
 
-    PyEval_SaveThread();
-  } else {
-    PyErr_Format(PyExc_RuntimeError, "Unknown exec type `%d` ", type);
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(entries); i++) {
+    entry = PyList_GET_ITEM(entries, i);
+    capsule = PyList_GET_ITEM(entry, JCP_CLASS_ENTRY_CLASS);
+    cached_class = (jclass)PyCapsule_GetPointer(capsule, NULL);
+    if ((*env)->IsSameObject(env, cached_class, clazz)) {
+      return entry;
+    }
   }
 
-  PyEval_AcquireThread(jcp_thread->tstate);
+  return NULL;
+}
 
-  if (type == 0) {
-    globals = PyDict_New();
-    PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
-  } else if (type == 1) {
-    PyObject *mod_main = PyImport_AddModule("__main__"); /* borrowed */
-    if (mod_main == NULL) {
-      PyEval_ReleaseThread(jcp_thread->tstate);
-      return 0;
+/* Creates the cache entry of a Java class. Returns a borrowed reference. */
+
+static PyObject *jcp_class_cache_new_entry(JNIEnv *env, PyObject *cache,
+                                           jclass clazz, PyObject *class_name) {
+  PyObject *entries, *entry, *capsule, *attrs;
+  jclass cached_class;
+  int ret;
+
+  entries = PyDict_GetItem(cache, class_name);
+  if (!entries) {
+    entries = PyList_New(0);
+    if (!entries) {
+      return NULL;
+    }
+    ret = PyDict_SetItem(cache, class_name, entries);
+    Py_DECREF(entries);
+    if (ret < 0) {
+      return NULL;
     }
-    globals = PyModule_GetDict(mod_main);
-    Py_INCREF(globals);
   }
 
-  if ((tdict = PyThreadState_GetDict()) != NULL) {
-    // Capsule objects let you wrap a C "void *" pointer in a Python object.
-    t = PyCapsule_New((void *)jcp_thread, NULL, NULL);
-    key = PyUnicode_FromString(DICT_KEY);
+  cached_class = (*env)->NewGlobalRef(env, clazz);
+  capsule = PyCapsule_New(cached_class, NULL, jcp_class_capsule_destructor);
+  if (!capsule) {
+    (*env)->DeleteGlobalRef(env, cached_class);
+    return NULL;
+  }
 
-    PyDict_SetItem(tdict, key, t); /* takes ownership */
+  attrs = PyDict_New();
+  entry = PyList_New(3);
+  if (!attrs || !entry) {
+    Py_DECREF(capsule);
+    Py_XDECREF(attrs);
+    Py_XDECREF(entry);
+    return NULL;
+  }
 
-    Py_DECREF(key);
-    Py_DECREF(t);
+  Py_INCREF(Py_None);
+  PyList_SET_ITEM(entry, JCP_CLASS_ENTRY_CLASS, capsule);
+  PyList_SET_ITEM(entry, JCP_CLASS_ENTRY_ATTRS, attrs);
+  PyList_SET_ITEM(entry, JCP_CLASS_ENTRY_TYPE, Py_None);
+
+  ret = PyList_Append(entries, entry);
+  Py_DECREF(entry);
+  return ret < 0 ? NULL : entry;
+}
+
+/* Finds the cache entry of a Java class and creates it if required. Returns a
+ * new reference, or NULL without an exception set if the class isn't cached.
+ * The cache of the Main Interpreter is cleared once its last JcpThread exits,
+ * so the entry is looked up with the lock and outlives the clearing. */
+
+static PyObject *jcp_class_cache_entry(JNIEnv *env, jclass clazz,
+                                       PyObject *class_name, int create) {
+  PyObject **cache, *entries, *entry = NULL;
+
+  cache = jcp_class_cache();
+  if (!cache) {
+    return NULL;
   }
 
-  // Init JcpThread
-  jcp_thread->globals = globals;
-  jcp_thread->env = env;
-  jcp_thread->cache_function_name = NULL;
-  jcp_thread->cache_object_name = NULL;
-  jcp_thread->cache_method_name = NULL;
-  jcp_thread->cache_callable = NULL;
-  jcp_thread->name_to_attrs = NULL;
-  jcp_thread->pemja_module = pemja_module_init(env);
+  JcpClassCache_LOCK();
+  if (!*cache && create) {
+    *cache = PyDict_New();
+  }
 
-  PyEval_ReleaseThread(jcp_thread->tstate);
+  if (*cache) {
+    entries = PyDict_GetItem(*cache, class_name);
+    if (entries) {
+      entry = jcp_class_cache_find(env, entries, clazz);
+    }
+    if (!entry && create) {
+      entry = jcp_class_cache_new_entry(env, *cache, clazz, class_name);
+    }
+  }
 
-  return (intptr_t)jcp_thread;
+  Py_XINCREF(entry);
+  JcpClassCache_UNLOCK();
+
+  return entry;
 }
 
-/*
- * Finalize JcpThread.
- */
+/* Get the cached methods and fields of a Java class */
 
-void JcpPy_FinalizeThread(intptr_t ptr) {
+PyObject *JcpClassAttrs_Get(JNIEnv *env, jclass clazz, PyObject *class_name) {
+  PyObject *entry, *attrs;
+
+  entry = jcp_class_cache_entry(env, clazz, class_name, 1);
+  if (!entry) {
+    return PyErr_Occurred() ? NULL : PyDict_New();
+  }
+
+  attrs = PyList_GET_ITEM(entry, JCP_CLASS_ENTRY_ATTRS);
+  Py_INCREF(attrs);
+  Py_DECREF(entry);
+  return attrs;
+}
+
+/* Check whether the Python types of Java classes can be cached. They subclass
+ * the PyJObject_Type of the interpreter, so the cache of the interpreter is
+ * required. */
+
+int JcpClassType_Enabled(void) {
   JcpThread *jcp_thread;
 
-  PyObject *tdict, *key;
+  if (PyThreadState_Get()->interp == JcpMainThreadState->interp) {
+    return 1;
+  }
 
-  jcp_thread = (JcpThread *)ptr;
+  jcp_thread = JcpThread_Get();
   if (!jcp_thread) {
-    printf("WARNING: thread_close, invalid JcpThread pointer.\n");
-    return;
+    // a thread created in Python, the types couldn't be cached anyway
+    PyErr_Clear();
+    return 0;
   }
 
-  PyEval_AcquireThread(jcp_thread->tstate);
-
-  key = PyUnicode_FromString(DICT_KEY);
-  if ((tdict = PyThreadState_GetDict()) != NULL && key != NULL) {
-    PyDict_DelItem(tdict, key);
-  }
+  return 1;
+}
 
-  Py_DECREF(key);
+/* Get the cached Python type of a Java class. Returns a new reference. */
 
-  Py_CLEAR(jcp_thread->globals);
-  Py_CLEAR(jcp_thread->name_to_attrs);
-  Py_CLEAR(jcp_thread->pemja_module);
+PyTypeObject *JcpClassType_Get(JNIEnv *env, jclass clazz,
+                               PyObject *class_name) {
+  PyObject *entry, *type;
 
-  if (jcp_thread->cache_function_name) {
-    free(jcp_thread->cache_function_name);
+  entry = jcp_class_cache_entry(env, clazz, class_name, 0);
+  if (!entry) {
+    return NULL;
   }
 
-  if (jcp_thread->cache_object_name) {
-    free(jcp_thread->cache_object_name);
+  JcpClassCache_LOCK();
+  type = PyList_GET_ITEM(entry, JCP_CLASS_ENTRY_TYPE);
+  if (type == Py_None) {
+    type = NULL;
   }
+  Py_XINCREF(type);
+  JcpClassCache_UNLOCK();
 
-  if (jcp_thread->cache_method_name) {
-    free(jcp_thread->cache_method_name);
-  }
+  Py_DECREF(entry);
+  return (PyTypeObject *)type;
+}
 
-  Py_XDECREF(jcp_thread->cache_callable);
+/* Cache the Python type of a Java class. The type cached by another thread
+ * meanwhile is kept, as the callers may be using it already. Returns a new
+ * reference. */
 
-  if (jcp_thread->tstate->interp == JcpMainThreadState->interp) {
-    PyThreadState_Clear(jcp_thread->tstate);
-    PyEval_ReleaseThread(jcp_thread->tstate);
-    PyThreadState_Delete(jcp_thread->tstate);
-  } else {
-    Py_EndInterpreter(jcp_thread->tstate);
-    PyThreadState_Swap(JcpMainThreadState);
-    PyEval_ReleaseThread(JcpMainThreadState);
+PyTypeObject *JcpClassType_Put(JNIEnv *env, jclass clazz, PyObject *class_name,
+                               PyTypeObject *type) {
+  PyObject *entry, *cached;
+
+  entry = jcp_class_cache_entry(env, clazz, class_name, 1);
+  if (!entry) {
+    return NULL;
   }
 
-  free(jcp_thread);
+  JcpClassCache_LOCK();
+  cached = PyList_GET_ITEM(entry, JCP_CLASS_ENTRY_TYPE);
+  if (cached == Py_None) {
+    Py_INCREF(type);
+    PyList_SET_ITEM(entry, JCP_CLASS_ENTRY_TYPE, (PyObject *)type);
+    cached = (PyObject *)type;
+  }
+  Py_INCREF(cached);
+  JcpClassCache_UNLOCK();
+
+  Py_DECREF(entry);
+  return (PyTypeObject *)cached;
 }
 
 /* Add path to search path of Main Interpreter */
@@ -898,6 +1947,80 @@ exit:
       return result;
 }
 
+/* Call a coroutine function and run its coroutine in the event loop of the
+ * JcpThread, which is started by the first call. The Java future is completed
+ * in the thread of the event loop once the coroutine is done. */
+
+void JcpPyObject_CallAsync(JNIEnv *env, intptr_t ptr, const char *name,
+                           jobjectArray args, jobject future) {
+  int arg_len = 0;
+
+  PyObject *callable;
+  PyObject *py_args;
+  PyObject *module;
+  PyObject *capsule;
+  PyObject *coroutine = NULL;
+  PyObject *py_future = NULL;
+  PyObject *py_ret = NULL;
+
+  jobject element;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      callable = _JcpPyFunction_Load(env, jcp_thread, name);
+  if (!callable) {
+    goto exit;
+  }
+
+  if (args != NULL) {
+    arg_len = (*env)->GetArrayLength(env, args);
+  }
+
+  py_args = PyTuple_New(arg_len);
+  for (int i = 0; i < arg_len; i++) {
+    element = (*env)->GetObjectArrayElement(env, args, i);
+    PyTuple_SetItem(py_args, i, JcpPyObject_FromJObject(env, element));
+    (*env)->DeleteLocalRef(env, element);
+  }
+
+  coroutine = PyObject_CallObject(callable, py_args);
+  Py_DECREF(py_args);
+  if (!coroutine) {
+    goto exit;
+  }
+
+  if (!jcp_thread->event_loop) {
+    module = PyImport_ImportModule("pemja.event_loop");
+    capsule = PyCapsule_New((void *)jcp_thread, NULL, NULL);
+    if (module != NULL && capsule != NULL) {
+      jcp_thread->event_loop =
+          PyObject_CallMethod(module, "EventLoop", "O", capsule);
+    }
+    Py_XDECREF(module);
+    Py_XDECREF(capsule);
+    if (!jcp_thread->event_loop) {
+      goto exit;
+    }
+  }
+
+  py_future = JcpPyObject_FromJObject(env, future);
+  if (!py_future) {
+    goto exit;
+  }
+
+  py_ret = PyObject_CallMethod(jcp_thread->event_loop, "submit", "OO",
+                               coroutine, py_future);
+
+exit:
+  JcpPyErr_Throw(env);
+
+  Py_XDECREF(coroutine);
+  Py_XDECREF(py_future);
+  Py_XDECREF(py_ret);
+
+  Jcp_END_ALLOW_THREADS
+}
+
 /* Call the method named 'name' of object 'obj' without arguments */
 
 jobject JcpPyObject_CallMethodNoArgs(JNIEnv *env, intptr_t ptr, const char *obj,
@@ -1097,6 +2220,55 @@ exit:
 
 // ----------------------------------------------------------------------------------------
 
+/* Import an Arrow C Data Interface ArrowArray/ArrowSchema pair as a
+ * pyarrow.RecordBatch */
+
+jobject JcpPyArrow_ImportRecordBatch(JNIEnv *env, intptr_t ptr, jlong array,
+                                     jlong schema) {
+  PyObject *pyarrow;
+  PyObject *record_batch_type = NULL;
+  PyObject *py_batch = NULL;
+
+  jobject result = NULL;
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      // pyarrow is an optional dependency, so it is only imported on demand.
+      pyarrow = PyImport_ImportModule("pyarrow");
+
+  if (pyarrow == NULL) {
+    JcpPyErr_Throw(env);
+    goto exit;
+  }
+
+  record_batch_type = PyObject_GetAttrString(pyarrow, "RecordBatch");
+  Py_DECREF(pyarrow);
+
+  if (record_batch_type == NULL) {
+    JcpPyErr_Throw(env);
+    goto exit;
+  }
+
+  // `_import_from_c` moves both structs into pyarrow without copying the
+  // buffers: it takes over their release callbacks and marks the structs as
+  // released, so the exporter must not release them again.
+  py_batch = PyObject_CallMethod(record_batch_type, "_import_from_c", "LL",
+                                 (long long)array, (long long)schema);
+
+  if (JcpPyErr_Throw(env) || !py_batch) {
+    goto exit;
+  }
+
+  result = JcpPyObject_AsJPyObject(env, py_batch);
+
+exit:
+  Py_XDECREF(py_batch);
+  Py_XDECREF(record_batch_type);
+  Jcp_END_ALLOW_THREADS
+
+      return result;
+}
+
 /* Exec python code */
 
 void JcpExec(JNIEnv *env, intptr_t ptr, const char *code) {
@@ -1119,3 +2291,120 @@ void JcpExec(JNIEnv *env, intptr_t ptr, const char *code) {
 
   Jcp_END_ALLOW_THREADS
 }
+
+/* Copy a function defined by the warm-up code, so that it reads and writes the
+ * globals of the thread instead of the template. The getters return NULL for
+ * the attributes a function doesn't have, which the setters don't accept. */
+
+static PyObject *jcp_rebind_function(PyObject *func, PyObject *globals) {
+  PyObject *qualname, *result, *attrs, *defaults, *kwdefaults, *annotations;
+
+  qualname = PyObject_GetAttrString(func, "__qualname__");
+  if (!qualname) {
+    return NULL;
+  }
+
+  result = PyFunction_NewWithQualName(PyFunction_GetCode(func), globals,
+                                      qualname);
+  Py_DECREF(qualname);
+  if (!result) {
+    return NULL;
+  }
+
+  defaults = PyFunction_GetDefaults(func);
+  kwdefaults = PyFunction_GetKwDefaults(func);
+  annotations = PyFunction_GetAnnotations(func);
+
+  attrs = PyObject_GetAttrString(func, "__dict__");
+  if (!attrs || (defaults && PyFunction_SetDefaults(result, defaults) < 0) ||
+      (kwdefaults && PyFunction_SetKwDefaults(result, kwdefaults) < 0) ||
+      (annotations && PyFunction_SetAnnotations(result, annotations) < 0) ||
+      PyObject_SetAttrString(result, "__dict__", attrs) < 0) {
+    Py_XDECREF(attrs);
+    Py_DECREF(result);
+    return NULL;
+  }
+  Py_DECREF(attrs);
+
+  return result;
+}
+
+static int jcp_rebind_functions(PyObject *globals, PyObject *template) {
+  PyObject *key, *value, *func;
+  Py_ssize_t pos = 0;
+
+  while (PyDict_Next(template, &pos, &key, &value)) {
+    // the closures, e.g. returned by a factory of the code, can't be copied to
+    // other globals, so they are shared like the other objects
+    if (!PyFunction_Check(value) || PyFunction_GetGlobals(value) != template ||
+        PyFunction_GetClosure(value) != NULL) {
+      continue;
+    }
+
+    func = jcp_rebind_function(value, globals);
+    if (!func || PyDict_SetItem(globals, key, func) < 0) {
+      Py_XDECREF(func);
+      return -1;
+    }
+    Py_DECREF(func);
+  }
+
+  return 0;
+}
+
+/*
+ * Exec the warm-up code of a thread of the Main Interpreter. The code runs only
+ * once in a template namespace copied from the globals of the first thread,
+ * and the globals of every thread running the same code are updated with a
+ * shallow copy of the template. The functions defined at the top level of the
+ * code are copied to use the globals of the thread, while the other objects,
+ * e.g. the modules and the classes, are shared by the threads.
+ */
+
+void JcpExecTemplate(JNIEnv *env, intptr_t ptr, const char *code) {
+  PyObject *key, *template = NULL, *cached, *result;
+  int status = -1;
+
+  if (code == NULL) {
+    return;
+  }
+
+  Jcp_BEGIN_ALLOW_THREADS
+
+      key = PyUnicode_FromString(code);
+  if (key) {
+    template = PyDict_GetItem(JcpMainTemplates, key);
+    Py_XINCREF(template);
+  }
+
+  if (key && !template) {
+    template = PyDict_Copy(jcp_thread->globals);
+    result = template ? PyRun_String(code, Py_file_input, template, template)
+                      : NULL;
+    if (result) {
+      Py_DECREF(result);
+      // keeps the template of another thread running the code meanwhile
+      cached = PyDict_SetDefault(JcpMainTemplates, key, template);
+      Py_XINCREF(cached);
+      Py_DECREF(template);
+      template = cached;
+    } else {
+      Py_CLEAR(template);
+    }
+  }
+
+  if (template) {
+    status = PyDict_Update(jcp_thread->globals, template);
+    if (status == 0) {
+      status = jcp_rebind_functions(jcp_thread->globals, template);
+    }
+    Py_DECREF(template);
+  }
+  Py_XDECREF(key);
+
+  if (status < 0) {
+    JcpPyErr_Throw(env);
+  }
+
+  Jcp_END_ALLOW_THREADS
+}
@@ -0,0 +1,102 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "Pemja.h"
+#include "java_class/JavaClass.h"
+#include "python_class/PythonClass.h"
+
+/* Creates a new PyJBufferedIteratorObject with a Java Iterator Object. */
+
+PyObject* JcpPyJBufferedIterator_New(JNIEnv* env, jobject iterator,
+                                     jclass clazz) {
+  PyJBufferedIteratorObject* self;
+
+  self = (PyJBufferedIteratorObject*)JcpPyJObject_New(
+      env, &PyJBufferedIterator_Type, iterator, clazz);
+
+  if (self) {
+    self->chunk = NULL;
+    self->position = 0;
+    self->exhausted = 0;
+  }
+
+  return (PyObject*)self;
+}
+
+static void pyjbufferediterator_dealloc(PyJBufferedIteratorObject* self) {
+  Py_CLEAR(self->chunk);
+  Py_TYPE(self)->tp_base->tp_dealloc((PyObject*)self);
+}
+
+/* Fetches the next chunk of elements from the Java Iterator. */
+
+static int pyjbufferediterator_fetch(PyJBufferedIteratorObject* self) {
+  JNIEnv* env;
+  jobjectArray chunk;
+
+  env = JcpThreadEnv_Get();
+
+  chunk = JavaIteratorUtils_nextChunk(env, self->object,
+                                      JCP_ITERATOR_CHUNK_SIZE);
+
+  if (JcpJavaErr_Throw(env)) {
+    return -1;
+  }
+
+  Py_CLEAR(self->chunk);
+  self->chunk = JcpPyTuple_FromJObjectArray(env, chunk);
+  self->position = 0;
+  self->exhausted =
+      (*env)->GetArrayLength(env, chunk) < JCP_ITERATOR_CHUNK_SIZE;
+
+  (*env)->DeleteLocalRef(env, chunk);
+
+  return self->chunk == NULL ? -1 : 0;
+}
+
+static PyObject* pyjbufferediterator_next(PyJBufferedIteratorObject* self) {
+  PyObject* item;
+
+  if (self->chunk == NULL || self->position >= PyTuple_GET_SIZE(self->chunk)) {
+    if (self->exhausted || pyjbufferediterator_fetch(self) < 0) {
+      return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(self->chunk) == 0) {
+      return NULL;
+    }
+  }
+
+  item = PyTuple_GET_ITEM(self->chunk, self->position++);
+  Py_INCREF(item);
+
+  return item;
+}
+
+static PyType_Slot pyjbufferediterator_slots[] = {
+    {Py_tp_doc, "Java Iterator Object fetching elements in chunks"},
+    {Py_tp_dealloc, (void*)pyjbufferediterator_dealloc},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext, (void*)pyjbufferediterator_next},
+    {0, NULL},
+};
+
+PyType_Spec PyJBufferedIterator_Spec = {
+    "pemja.PyJBufferedIterator",       /* name */
+    sizeof(PyJBufferedIteratorObject), /* basicsize */
+    0,                                 /* itemsize */
+    Py_TPFLAGS_DEFAULT,                /* flags */
+    pyjbufferediterator_slots,         /* slots */
+};
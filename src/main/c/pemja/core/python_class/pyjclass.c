@@ -105,7 +105,7 @@ static PyObject *pyjclass_call(PyJClassObject *self, PyObject *args,
 
 static void pyjclass_dealloc(PyJClassObject *self) {
   Py_CLEAR(self->constructor);
-  PyJClass_Type.tp_base->tp_dealloc((PyObject *)self);
+  Py_TYPE(self)->tp_base->tp_dealloc((PyObject *)self);
 }
 
 /* Creates a new PyJClassObject with a Java Class Object. */
@@ -124,42 +124,17 @@ PyObject *JcpPyJClass_New(JNIEnv *env, jclass clazz) {
   return self;
 }
 
-PyTypeObject PyJClass_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJClass", /* tp_name */
-    sizeof(PyJClassObject),                          /* tp_basicsize */
-    0,                                               /* tp_itemsize */
-    (destructor)pyjclass_dealloc,                    /* tp_dealloc */
-    0,                                               /* tp_print */
-    0,                                               /* tp_getattr */
-    0,                                               /* tp_setattr */
-    0,                                               /* tp_reserved */
-    0,                                               /* tp_repr */
-    0,                                               /* tp_as_number */
-    0,                                               /* tp_as_sequence */
-    0,                                               /* tp_as_mapping */
-    0,                                               /* tp_hash */
-    (ternaryfunc)pyjclass_call,                      /* tp_call */
-    0,                                               /* tp_str */
-    0,                                               /* tp_getattro */
-    0,                                               /* tp_setattro */
-    0,                                               /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                              /* tp_flags */
-    "Java Class Object",                             /* tp_doc */
-    0,                                               /* tp_traverse */
-    0,                                               /* tp_clear */
-    0,                                               /* tp_richcompare */
-    0,                                               /* tp_weaklistoffset */
-    0,                                               /* tp_iter */
-    0,                                               /* tp_iternext */
-    0,                                               /* tp_methods */
-    0,                                               /* tp_members */
-    0,                                               /* tp_getset */
-    0,                                               /* tp_base */
-    0,                                               /* tp_dict */
-    0,                                               /* tp_descr_get */
-    0,                                               /* tp_descr_set */
-    0,                                               /* tp_dictoffset */
-    0,                                               /* tp_init */
-    0,                                               /* tp_alloc */
-    0,                                               /* tp_new */
+static PyType_Slot pyjclass_slots[] = {
+    {Py_tp_doc, "Java Class Object"},
+    {Py_tp_dealloc, (void *)pyjclass_dealloc},
+    {Py_tp_call, (void *)pyjclass_call},
+    {0, NULL},
+};
+
+PyType_Spec PyJClass_Spec = {
+    "pemja.PyJClass",       /* name */
+    sizeof(PyJClassObject), /* basicsize */
+    0,                      /* itemsize */
+    Py_TPFLAGS_DEFAULT,     /* flags */
+    pyjclass_slots,         /* slots */
 };
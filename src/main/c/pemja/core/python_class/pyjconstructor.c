@@ -31,10 +31,13 @@ static int pyjconstructor_init(JNIEnv *env, PyJMethodObject *self) {
     goto EXIT_ERROR;
   }
 
-  self->md_params = (*env)->NewGlobalRef(env, parameters);
-  self->md_params_num = (*env)->GetArrayLength(env, parameters);
+  if (JcpPyJMethod_InitParams(env, self, parameters) < 0) {
+    goto EXIT_ERROR;
+  }
+
   self->md_return_id = JOBJECT_ID;
   self->md_is_static = 1;
+  self->md_is_initialized = 1;
 
   (*env)->PopLocalFrame(env, NULL);
   return 0;
@@ -49,8 +52,11 @@ static PyObject *pyjconstructor_call(PyJMethodObject *self, PyObject *args,
   PyObject *arg, *pyobject;
   PyJClassObject *clazz;
 
+  PyJMethodParam *param;
+
   JNIEnv *env;
-  jvalue *jargs;
+  jvalue stack_jargs[JCP_METHOD_STACK_ARGS];
+  jvalue *jargs = stack_jargs;
   jobject object;
 
   if (kwargs != NULL) {
@@ -79,17 +85,18 @@ static PyObject *pyjconstructor_call(PyJMethodObject *self, PyObject *args,
     return NULL;
   }
 
-  jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * self->md_params_num);
-
-  for (int i = 0; i < self->md_params_num; i++) {
-    arg = PyTuple_GetItem(args, i + 1);
-    jclass paramType =
-        (jclass)(*env)->GetObjectArrayElement(env, self->md_params, i);
-    if (JcpJavaErr_Throw(env)) {
+  if (self->md_params_num > JCP_METHOD_STACK_ARGS) {
+    jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * self->md_params_num);
+    if (!jargs) {
+      PyErr_NoMemory();
       goto EXIT_ERROR;
     }
-    jargs[i] = JcpPyObject_AsJValue(env, arg, paramType);
-    (*env)->DeleteLocalRef(env, paramType);
+  }
+
+  for (int i = 0; i < self->md_params_num; i++) {
+    arg = PyTuple_GET_ITEM(args, i + 1);
+    param = &self->md_param_types[i];
+    jargs[i] = _JcpPyObject_AsJValue(env, arg, param->type, param->converter);
     if (JcpJavaErr_Throw(env) || PyErr_Occurred()) {
       goto EXIT_ERROR;
     }
@@ -106,12 +113,16 @@ static PyObject *pyjconstructor_call(PyJMethodObject *self, PyObject *args,
     goto EXIT_ERROR;
   }
 
-  PyMem_Free(jargs);
+  if (jargs != stack_jargs) {
+    PyMem_Free(jargs);
+  }
   (*env)->PopLocalFrame(env, NULL);
   return pyobject;
 
 EXIT_ERROR:
-  PyMem_Free(jargs);
+  if (jargs != stack_jargs) {
+    PyMem_Free(jargs);
+  }
   (*env)->PopLocalFrame(env, NULL);
   return NULL;
 }
@@ -121,20 +132,14 @@ EXIT_ERROR:
 PyObject *JcpPyJConstructor_New(JNIEnv *env, jobject constructor) {
   PyJMethodObject *self;
 
-  if (PyType_Ready(&PyJMethod_Type) < 0) {
-    return NULL;
-  }
-
-  if (!PyJConstructor_Type.tp_base) {
-    PyJConstructor_Type.tp_base = &PyJMethod_Type;
-    if (PyType_Ready(&PyJConstructor_Type) < 0) {
-      return NULL;
-    }
-  }
-
   self = PyObject_NEW(PyJMethodObject, &PyJConstructor_Type);
   self->md = (*env)->NewGlobalRef(env, constructor);
   self->md_name = PyUnicode_FromString("<init>");
+  self->md_params_num = 0;
+  self->md_param_types = NULL;
+  self->md_is_varargs = 0;
+  self->md_needs_local_frame = 1;
+  self->md_keeps_gil = 0;
 
   if (pyjconstructor_init(env, self) < 0 || JcpJavaErr_Throw(env)) {
     Py_DECREF(self);
@@ -144,42 +149,16 @@ PyObject *JcpPyJConstructor_New(JNIEnv *env, jobject constructor) {
   return (PyObject *)self;
 }
 
-PyTypeObject PyJConstructor_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJConstructor", /* tp_name */
-    sizeof(PyJMethodObject),                               /* tp_basicsize */
-    0,                                                     /* tp_itemsize */
-    0,                                                     /* tp_dealloc */
-    0,                                                     /* tp_print */
-    0,                                                     /* tp_getattr */
-    0,                                                     /* tp_setattr */
-    0,                                                     /* tp_reserved */
-    0,                                                     /* tp_repr */
-    0,                                                     /* tp_as_number */
-    0,                                                     /* tp_as_sequence */
-    0,                                                     /* tp_as_mapping */
-    0,                                                     /* tp_hash */
-    (ternaryfunc)pyjconstructor_call,                      /* tp_call */
-    0,                                                     /* tp_str */
-    0,                                                     /* tp_getattro */
-    0,                                                     /* tp_setattro */
-    0,                                                     /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                                    /* tp_flags */
-    "Java Constructor Object s",                           /* tp_doc */
-    0,                                                     /* tp_traverse */
-    0,                                                     /* tp_clear */
-    0,                                                     /* tp_richcompare */
-    0, /* tp_weaklistoffset */
-    0, /* tp_iter */
-    0, /* tp_iternext */
-    0, /* tp_methods */
-    0, /* tp_members */
-    0, /* tp_getset */
-    0, /* tp_base */
-    0, /* tp_dict */
-    0, /* tp_descr_get */
-    0, /* tp_descr_set */
-    0, /* tp_dictoffset */
-    0, /* tp_init */
-    0, /* tp_alloc */
-    0, /* tp_new */
+static PyType_Slot pyjconstructor_slots[] = {
+    {Py_tp_doc, "Java Constructor Object s"},
+    {Py_tp_call, (void *)pyjconstructor_call},
+    {0, NULL},
+};
+
+PyType_Spec PyJConstructor_Spec = {
+    "pemja.PyJConstructor",  /* name */
+    sizeof(PyJMethodObject), /* basicsize */
+    0,                       /* itemsize */
+    Py_TPFLAGS_DEFAULT,      /* flags */
+    pyjconstructor_slots,    /* slots */
 };
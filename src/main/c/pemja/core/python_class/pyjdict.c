@@ -37,19 +37,6 @@ static int PyJDict_Contains(PyObject* self, PyObject* key) {
   }
 }
 
-static PySequenceMethods pyjdict_as_sequence = {
-    0,                /* sq_length */
-    0,                /* sq_concat */
-    0,                /* sq_repeat */
-    0,                /* sq_item */
-    0,                /* sq_slice */
-    0,                /* sq_ass_item */
-    0,                /* sq_ass_slice */
-    PyJDict_Contains, /* sq_contains */
-    0,                /* sq_inplace_concat */
-    0,                /* sq_inplace_repeat */
-};
-
 static Py_ssize_t pyjdict_length(PyObject* self) {
   JNIEnv* env = JcpThreadEnv_Get();
 
@@ -89,12 +76,6 @@ static int pyjdict_ass_sub(PyObject* self, PyObject* key, PyObject* value) {
   return 0;
 }
 
-static PyMappingMethods pyjdict_as_mapping = {
-    pyjdict_length,    /* mp_length */
-    pyjdict_subscript, /* mp_subscript */
-    pyjdict_ass_sub,   /* mp_ass_subscript */
-};
-
 static PyObject* PyJObject_keys(PyObject* self) {
   JNIEnv* env = JcpThreadEnv_Get();
   return JcpPyObject_FromJObject(
@@ -128,42 +109,21 @@ static PyMethodDef dict_methods[] = {
     {NULL, NULL, 0, NULL},
 };
 
-PyTypeObject PyJDict_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJDict", /* tp_name */
-    sizeof(PyJObject),                              /* tp_basicsize */
-    0,                                              /* tp_itemsize */
-    0,                                              /* tp_dealloc */
-    0,                                              /* tp_print */
-    0,                                              /* tp_getattr */
-    0,                                              /* tp_setattr */
-    0,                                              /* tp_reserved */
-    0,                                              /* tp_repr */
-    0,                                              /* tp_as_number */
-    &pyjdict_as_sequence,                           /* tp_as_sequence */
-    &pyjdict_as_mapping,                            /* tp_as_mapping */
-    PyObject_HashNotImplemented,                    /* tp_hash */
-    0,                                              /* tp_call */
-    0,                                              /* tp_str */
-    0,                                              /* tp_getattro */
-    0,                                              /* tp_setattro */
-    0,                                              /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,       /* tp_flags */
-    "Java Map Object",                              /* tp_doc */
-    0,                                              /* tp_traverse */
-    0,                                              /* tp_clear */
-    0,                                              /* tp_richcompare */
-    0,                                              /* tp_weaklistoffset */
-    0,                                              /* tp_iter */
-    0,                                              /* tp_iternext */
-    dict_methods,                                   /* tp_methods */
-    0,                                              /* tp_members */
-    0,                                              /* tp_getset */
-    0,                                              /* tp_base */
-    0,                                              /* tp_dict */
-    0,                                              /* tp_descr_get */
-    0,                                              /* tp_descr_set */
-    0,                                              /* tp_dictoffset */
-    0,                                              /* tp_init */
-    0,                                              /* tp_alloc */
-    0,                                              /* tp_new */
+static PyType_Slot pyjdict_slots[] = {
+    {Py_tp_doc, "Java Map Object"},
+    {Py_tp_hash, (void*)PyObject_HashNotImplemented},
+    {Py_tp_methods, dict_methods},
+    {Py_sq_contains, (void*)PyJDict_Contains},
+    {Py_mp_length, (void*)pyjdict_length},
+    {Py_mp_subscript, (void*)pyjdict_subscript},
+    {Py_mp_ass_subscript, (void*)pyjdict_ass_sub},
+    {0, NULL},
+};
+
+PyType_Spec PyJDict_Spec = {
+    "pemja.PyJDict",                          /* name */
+    sizeof(PyJObject),                        /* basicsize */
+    0,                                        /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* flags */
+    pyjdict_slots,                            /* slots */
 };
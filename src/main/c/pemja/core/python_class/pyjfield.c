@@ -19,7 +19,6 @@
 static int pyjfield_init(JNIEnv* env, PyJFieldObject* self) {
   jint modifier;
 
-  env = JcpThreadEnv_Get();
   if ((*env)->PushLocalFrame(env, 16) != 0) {
     return -1;
   }
@@ -30,13 +29,14 @@ static int pyjfield_init(JNIEnv* env, PyJFieldObject* self) {
 
   modifier = JavaField_getModifiers(env, self->fd);
   self->fd_is_static = JavaModifier_isStatic(env, modifier);
-  self->fd_is_initialized = 1;
+  Jcp_STORE_RELEASE(self->fd_is_initialized, 1);
 
   (*env)->PopLocalFrame(env, NULL);
   return 0;
 }
 
 static void pyjfield_dealloc(PyJFieldObject* self) {
+  PyTypeObject* type = Py_TYPE(self);
   JNIEnv* env = JcpThreadEnv_Get();
 
   if (self->fd) {
@@ -47,6 +47,7 @@ static void pyjfield_dealloc(PyJFieldObject* self) {
   Py_CLEAR(self->fd_name);
 
   PyObject_Del(self);
+  Py_DECREF(type);
 }
 
 /* Creates a new PyJFieldObject with a Java Field Object. */
@@ -56,10 +57,6 @@ PyJFieldObject* JcpPyJField_New(JNIEnv* env, jobject field) {
 
   PyJFieldObject* self;
 
-  if (PyType_Ready(&PyJField_Type) < 0) {
-    return NULL;
-  }
-
   self = PyObject_NEW(PyJFieldObject, &PyJField_Type);
 
   fieldName = (jstring)JavaMember_getName(env, field);
@@ -75,23 +72,49 @@ PyJFieldObject* JcpPyJField_New(JNIEnv* env, jobject field) {
   return self;
 }
 
+/* Resolves the field ID and the type of the PyJFieldObject if required. */
+
+int JcpPyJField_Init(JNIEnv* env, PyJFieldObject* self) {
+  int ret = 0;
+
+  if (Jcp_LOAD_ACQUIRE(self->fd_is_initialized)) {
+    return 0;
+  }
+
+  // threads of free-threaded Python may race on the first access
+  Jcp_BEGIN_CRITICAL_SECTION(self);
+  if (!self->fd_is_initialized) {
+    ret = pyjfield_init(env, self);
+  }
+  Jcp_END_CRITICAL_SECTION();
+
+  if (ret < 0) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "Failed to initialize the PyJFieldObject");
+  }
+  return ret;
+}
+
 /* Gets the filed of the PyJObject. */
 
 PyObject* JcpPyJField_Get(PyJFieldObject* self, PyJObject* pyjobject) {
   JNIEnv* env;
 
-  PyObject* result;
-
   env = JcpThreadEnv_Get();
 
-  if (!self->fd_is_initialized) {
-    if (pyjfield_init(env, self) < 0) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "Failed to initialize the PyJFieldObject");
-      return NULL;
-    }
+  if (JcpPyJField_Init(env, self) < 0) {
+    return NULL;
   }
 
+  return JcpPyJField_GetValue(env, self, pyjobject);
+}
+
+/* Gets the filed of the PyJObject with an initialized PyJFieldObject. */
+
+PyObject* JcpPyJField_GetValue(JNIEnv* env, PyJFieldObject* self,
+                               PyJObject* pyjobject) {
+  PyObject* result;
+
   result = NULL;
 
   switch (self->fd_type_id) {
@@ -221,14 +244,17 @@ int JcpPyJField_Set(PyJFieldObject* self, PyJObject* pyjobject,
   JNIEnv* env;
   env = JcpThreadEnv_Get();
 
-  if (!self->fd_is_initialized) {
-    if (pyjfield_init(env, self) < 0) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "Failed to initialize the PyJFieldObject");
-      return -1;
-    }
+  if (JcpPyJField_Init(env, self) < 0) {
+    return -1;
   }
 
+  return JcpPyJField_SetValue(env, self, pyjobject, value);
+}
+
+/* Sets the field value of the PyJObject with an initialized PyJFieldObject. */
+
+int JcpPyJField_SetValue(JNIEnv* env, PyJFieldObject* self,
+                         PyJObject* pyjobject, PyObject* value) {
   switch (self->fd_type_id) {
     case JBOOLEAN_ID: {
       jboolean object;
@@ -355,42 +381,41 @@ int JcpPyJField_Set(PyJFieldObject* self, PyJObject* pyjobject,
   return 0;
 }
 
-PyTypeObject PyJField_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJField", /* tp_name */
-    sizeof(PyJFieldObject),                          /* tp_basicsize */
-    0,                                               /* tp_itemsize */
-    (destructor)pyjfield_dealloc,                    /* tp_dealloc */
-    0,                                               /* tp_print */
-    0,                                               /* tp_getattr */
-    0,                                               /* tp_setattr */
-    0,                                               /* tp_reserved */
-    0,                                               /* tp_repr */
-    0,                                               /* tp_as_number */
-    0,                                               /* tp_as_sequence */
-    0,                                               /* tp_as_mapping */
-    0,                                               /* tp_hash */
-    0,                                               /* tp_call */
-    0,                                               /* tp_str */
-    0,                                               /* tp_getattro */
-    0,                                               /* tp_setattro */
-    0,                                               /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                              /* tp_flags */
-    "Java Field Object",                             /* tp_doc */
-    0,                                               /* tp_traverse */
-    0,                                               /* tp_clear */
-    0,                                               /* tp_richcompare */
-    0,                                               /* tp_weaklistoffset */
-    0,                                               /* tp_iter */
-    0,                                               /* tp_iternext */
-    0,                                               /* tp_methods */
-    0,                                               /* tp_members */
-    0,                                               /* tp_getset */
-    0,                                               /* tp_base */
-    0,                                               /* tp_dict */
-    0,                                               /* tp_descr_get */
-    0,                                               /* tp_descr_set */
-    0,                                               /* tp_dictoffset */
-    0,                                               /* tp_init */
-    0,                                               /* tp_alloc */
-    0,                                               /* tp_new */
+/* Gets and sets the field of a PyJObject when it is installed into the Python
+ * type of a Java class. */
+
+static PyObject* pyjfield_descr_get(PyObject* self, PyObject* obj,
+                                    PyObject* type) {
+  if (obj == NULL || obj == Py_None) {
+    Py_INCREF(self);
+    return self;
+  }
+
+  return JcpPyJField_Get((PyJFieldObject*)self, (PyJObject*)obj);
+}
+
+static int pyjfield_descr_set(PyObject* self, PyObject* obj, PyObject* value) {
+  if (value == NULL) {
+    PyErr_Format(PyExc_AttributeError, "Java field '%U' cannot be deleted.",
+                 ((PyJFieldObject*)self)->fd_name);
+    return -1;
+  }
+
+  return JcpPyJField_Set((PyJFieldObject*)self, (PyJObject*)obj, value);
+}
+
+static PyType_Slot pyjfield_slots[] = {
+    {Py_tp_doc, "Java Field Object"},
+    {Py_tp_dealloc, (void*)pyjfield_dealloc},
+    {Py_tp_descr_get, (void*)pyjfield_descr_get},
+    {Py_tp_descr_set, (void*)pyjfield_descr_set},
+    {0, NULL},
+};
+
+PyType_Spec PyJField_Spec = {
+    "pemja.PyJField",       /* name */
+    sizeof(PyJFieldObject), /* basicsize */
+    0,                      /* itemsize */
+    Py_TPFLAGS_DEFAULT,     /* flags */
+    pyjfield_slots,         /* slots */
 };
@@ -0,0 +1,268 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Pemja.h"
+#include "python_class/PythonClass.h"
+
+/* Creates a PyJFieldAccessor of the given fields of a Java class or object. */
+
+static PyObject* pyjfieldaccessor_new(PyTypeObject* type, PyObject* args,
+                                      PyObject* kwargs) {
+  PyObject *cls, *names, *name, *field;
+  PyJFieldAccessorObject* self;
+  PyJFieldObject* pyjfield;
+  Py_ssize_t len;
+
+  JNIEnv* env;
+
+  if (!PyArg_ParseTuple(args, "OO", &cls, &names)) {
+    return NULL;
+  }
+
+  if (!PyJObject_Check(cls)) {
+    PyErr_Format(PyExc_TypeError,
+                 "Expected a Java class or object, but got '%s'.",
+                 Py_TYPE(cls)->tp_name);
+    return NULL;
+  }
+
+  names = PySequence_Tuple(names);
+  if (!names) {
+    return NULL;
+  }
+
+  env = JcpThreadEnv_Get();
+
+  len = PyTuple_GET_SIZE(names);
+  self = (PyJFieldAccessorObject*)type->tp_alloc(type, 0);
+  if (!self) {
+    Py_DECREF(names);
+    return NULL;
+  }
+
+  self->clazz = (*env)->NewGlobalRef(env, ((PyJObject*)cls)->clazz);
+  self->fields = PyTuple_New(len);
+  self->has_instance_fields = 0;
+  if (!self->fields) {
+    goto EXIT_ERROR;
+  }
+
+  for (Py_ssize_t i = 0; i < len; i++) {
+    name = PyTuple_GET_ITEM(names, i);
+    if (!PyUnicode_Check(name)) {
+      PyErr_Format(PyExc_TypeError, "Field names must be str, not '%s'.",
+                   Py_TYPE(name)->tp_name);
+      goto EXIT_ERROR;
+    }
+
+    field = JcpPyJObject_GetMember((PyJObject*)cls, name);
+    if (!field) {
+      goto EXIT_ERROR;
+    }
+
+    if (!PyJField_Check(field)) {
+      PyErr_Format(PyExc_AttributeError, "'%U' has no field '%U'.",
+                   ((PyJObject*)cls)->class_name, name);
+      goto EXIT_ERROR;
+    }
+
+    // the IDs of the fields are resolved once for all the reads and writes
+    pyjfield = (PyJFieldObject*)field;
+    if (JcpPyJField_Init(env, pyjfield) < 0) {
+      goto EXIT_ERROR;
+    }
+
+    if (!pyjfield->fd_is_static) {
+      self->has_instance_fields = 1;
+    }
+
+    Py_INCREF(field);
+    PyTuple_SET_ITEM(self->fields, i, field);
+  }
+
+  Py_DECREF(names);
+  return (PyObject*)self;
+
+EXIT_ERROR:
+  Py_DECREF(names);
+  Py_DECREF(self);
+  return NULL;
+}
+
+static void pyjfieldaccessor_dealloc(PyJFieldAccessorObject* self) {
+  PyTypeObject* type = Py_TYPE(self);
+  JNIEnv* env = JcpThreadEnv_Get();
+
+  if (self->clazz) {
+    (*env)->DeleteGlobalRef(env, self->clazz);
+    self->clazz = NULL;
+  }
+
+  Py_CLEAR(self->fields);
+
+  type->tp_free((PyObject*)self);
+  Py_DECREF(type);
+}
+
+/* Checks that the fields can be accessed on the given PyJObject. */
+
+static int pyjfieldaccessor_check(JNIEnv* env, PyJFieldAccessorObject* self,
+                                  PyObject* obj) {
+  PyJObject* pyjobject;
+
+  if (!PyJObject_Check(obj)) {
+    PyErr_Format(PyExc_TypeError, "Expected a Java object, but got '%s'.",
+                 Py_TYPE(obj)->tp_name);
+    return -1;
+  }
+
+  pyjobject = (PyJObject*)obj;
+  if (!(*env)->IsAssignableFrom(env, pyjobject->clazz, self->clazz) ||
+      (!pyjobject->object && self->has_instance_fields)) {
+    PyErr_Format(PyExc_TypeError,
+                 "The fields can't be accessed on the Java object of '%U'.",
+                 pyjobject->class_name);
+    return -1;
+  }
+
+  return 0;
+}
+
+/* Reads all the fields of a Java object into a tuple. */
+
+static PyObject* pyjfieldreader_call(PyJFieldAccessorObject* self,
+                                     PyObject* args, PyObject* kwargs) {
+  PyObject *obj, *value, *result;
+  Py_ssize_t len;
+
+  JNIEnv* env;
+
+  if (!PyArg_ParseTuple(args, "O", &obj)) {
+    return NULL;
+  }
+
+  env = JcpThreadEnv_Get();
+  if (pyjfieldaccessor_check(env, self, obj) < 0) {
+    return NULL;
+  }
+
+  len = PyTuple_GET_SIZE(self->fields);
+  if ((*env)->PushLocalFrame(env, 16 + len) != 0) {
+    JcpJavaErr_Throw(env);
+    return NULL;
+  }
+
+  result = PyTuple_New(len);
+  for (Py_ssize_t i = 0; result && i < len; i++) {
+    value = JcpPyJField_GetValue(
+        env, (PyJFieldObject*)PyTuple_GET_ITEM(self->fields, i),
+        (PyJObject*)obj);
+    if (!value) {
+      Py_CLEAR(result);
+      break;
+    }
+    PyTuple_SET_ITEM(result, i, value);
+  }
+
+  (*env)->PopLocalFrame(env, NULL);
+  return result;
+}
+
+/* Writes all the fields of a Java object from a sequence of values. */
+
+static PyObject* pyjfieldwriter_call(PyJFieldAccessorObject* self,
+                                     PyObject* args, PyObject* kwargs) {
+  PyObject *obj, *values;
+  Py_ssize_t len;
+
+  JNIEnv* env;
+
+  if (!PyArg_ParseTuple(args, "OO", &obj, &values)) {
+    return NULL;
+  }
+
+  env = JcpThreadEnv_Get();
+  if (pyjfieldaccessor_check(env, self, obj) < 0) {
+    return NULL;
+  }
+
+  values = PySequence_Fast(values, "The values must be a sequence.");
+  if (!values) {
+    return NULL;
+  }
+
+  len = PyTuple_GET_SIZE(self->fields);
+  if (PySequence_Fast_GET_SIZE(values) != len) {
+    PyErr_Format(PyExc_ValueError, "Expected %zd values, but got %zd.", len,
+                 PySequence_Fast_GET_SIZE(values));
+    Py_DECREF(values);
+    return NULL;
+  }
+
+  if ((*env)->PushLocalFrame(env, 16 + len) != 0) {
+    JcpJavaErr_Throw(env);
+    Py_DECREF(values);
+    return NULL;
+  }
+
+  for (Py_ssize_t i = 0; i < len; i++) {
+    JcpPyJField_SetValue(env,
+                         (PyJFieldObject*)PyTuple_GET_ITEM(self->fields, i),
+                         (PyJObject*)obj, PySequence_Fast_GET_ITEM(values, i));
+    if (JcpJavaErr_Throw(env) || PyErr_Occurred()) {
+      break;
+    }
+  }
+
+  (*env)->PopLocalFrame(env, NULL);
+  Py_DECREF(values);
+
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
+static PyType_Slot pyjfieldreader_slots[] = {
+    {Py_tp_doc, "Reads the fields of Java objects into tuples"},
+    {Py_tp_dealloc, (void*)pyjfieldaccessor_dealloc},
+    {Py_tp_call, (void*)pyjfieldreader_call},
+    {Py_tp_new, (void*)pyjfieldaccessor_new},
+    {0, NULL},
+};
+
+PyType_Spec PyJFieldReader_Spec = {
+    "pemja.FieldReader",            /* name */
+    sizeof(PyJFieldAccessorObject), /* basicsize */
+    0,                              /* itemsize */
+    Py_TPFLAGS_DEFAULT,             /* flags */
+    pyjfieldreader_slots,           /* slots */
+};
+
+static PyType_Slot pyjfieldwriter_slots[] = {
+    {Py_tp_doc, "Writes the fields of Java objects"},
+    {Py_tp_dealloc, (void*)pyjfieldaccessor_dealloc},
+    {Py_tp_call, (void*)pyjfieldwriter_call},
+    {Py_tp_new, (void*)pyjfieldaccessor_new},
+    {0, NULL},
+};
+
+PyType_Spec PyJFieldWriter_Spec = {
+    "pemja.FieldWriter",            /* name */
+    sizeof(PyJFieldAccessorObject), /* basicsize */
+    0,                              /* itemsize */
+    Py_TPFLAGS_DEFAULT,             /* flags */
+    pyjfieldwriter_slots,           /* slots */
+};
@@ -32,49 +32,42 @@ static PyObject* pyjiterable_iterator(PyObject* self) {
   JNIEnv* env;
   jobject iterator;
 
+  PyObject* result;
+
   env = JcpThreadEnv_Get();
 
   iterator = JavaIterable_iterator(env, ((PyJObject*)self)->object);
 
-  return JcpPyObject_FromJObject(env, iterator);
+  if (JcpJavaErr_Throw(env)) {
+    return NULL;
+  }
+
+  if (PyJCollection_Check(self)) {
+    // Iterating a Java Collection has no side effects, so its elements can be
+    // fetched in chunks. A concurrent modification is only detected by the
+    // fetch of the next chunk, see ConversionPolicy#LAZY_PROXY. Other
+    // Iterables may be backed by lazy sources and keep to single-step
+    // iteration.
+    result = JcpPyJBufferedIterator_New(env, iterator, NULL);
+  } else {
+    result = JcpPyObject_FromJObject(env, iterator);
+  }
+
+  (*env)->DeleteLocalRef(env, iterator);
+
+  return result;
 }
 
-PyTypeObject PyJIterable_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJIterable", /* tp_name */
-    sizeof(PyJObject),                                  /* tp_basicsize */
-    0,                                                  /* tp_itemsize */
-    0,                                                  /* tp_dealloc */
-    0,                                                  /* tp_print */
-    0,                                                  /* tp_getattr */
-    0,                                                  /* tp_setattr */
-    0,                                                  /* tp_reserved */
-    0,                                                  /* tp_repr */
-    0,                                                  /* tp_as_number */
-    0,                                                  /* tp_as_sequence */
-    0,                                                  /* tp_as_mapping */
-    0,                                                  /* tp_hash */
-    0,                                                  /* tp_call */
-    0,                                                  /* tp_str */
-    0,                                                  /* tp_getattro */
-    0,                                                  /* tp_setattro */
-    0,                                                  /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,           /* tp_flags */
-    "Java Iterable Object",                             /* tp_doc */
-    0,                                                  /* tp_traverse */
-    0,                                                  /* tp_clear */
-    0,                                                  /* tp_richcompare */
-    0,                                                  /* tp_weaklistoffset */
-    (getiterfunc)pyjiterable_iterator,                  /* tp_iter */
-    0,                                                  /* tp_iternext */
-    0,                                                  /* tp_methods */
-    0,                                                  /* tp_members */
-    0,                                                  /* tp_getset */
-    0,                                                  /* tp_base */
-    0,                                                  /* tp_dict */
-    0,                                                  /* tp_descr_get */
-    0,                                                  /* tp_descr_set */
-    0,                                                  /* tp_dictoffset */
-    0,                                                  /* tp_init */
-    0,                                                  /* tp_alloc */
-    0,                                                  /* tp_new */
+static PyType_Slot pyjiterable_slots[] = {
+    {Py_tp_doc, "Java Iterable Object"},
+    {Py_tp_iter, (void*)pyjiterable_iterator},
+    {0, NULL},
+};
+
+PyType_Spec PyJIterable_Spec = {
+    "pemja.PyJIterable",                      /* name */
+    sizeof(PyJObject),                        /* basicsize */
+    0,                                        /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* flags */
+    pyjiterable_slots,                        /* slots */
 };
@@ -47,42 +47,17 @@ static PyObject* pyjiterator_next(PyObject* self) {
   return pyobject;
 }
 
-PyTypeObject PyJIterator_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJIterator", /* tp_name */
-    sizeof(PyJObject),                                  /* tp_basicsize */
-    0,                                                  /* tp_itemsize */
-    0,                                                  /* tp_dealloc */
-    0,                                                  /* tp_print */
-    0,                                                  /* tp_getattr */
-    0,                                                  /* tp_setattr */
-    0,                                                  /* tp_reserved */
-    0,                                                  /* tp_repr */
-    0,                                                  /* tp_as_number */
-    0,                                                  /* tp_as_sequence */
-    0,                                                  /* tp_as_mapping */
-    0,                                                  /* tp_hash */
-    0,                                                  /* tp_call */
-    0,                                                  /* tp_str */
-    0,                                                  /* tp_getattro */
-    0,                                                  /* tp_setattro */
-    0,                                                  /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                                 /* tp_flags */
-    "Java Iterator Object",                             /* tp_doc */
-    0,                                                  /* tp_traverse */
-    0,                                                  /* tp_clear */
-    0,                                                  /* tp_richcompare */
-    0,                                                  /* tp_weaklistoffset */
-    PyObject_SelfIter,                                  /* tp_iter */
-    (iternextfunc)pyjiterator_next,                     /* tp_iternext */
-    0,                                                  /* tp_methods */
-    0,                                                  /* tp_members */
-    0,                                                  /* tp_getset */
-    0,                                                  /* tp_base */
-    0,                                                  /* tp_dict */
-    0,                                                  /* tp_descr_get */
-    0,                                                  /* tp_descr_set */
-    0,                                                  /* tp_dictoffset */
-    0,                                                  /* tp_init */
-    0,                                                  /* tp_alloc */
-    0,                                                  /* tp_new */
+static PyType_Slot pyjiterator_slots[] = {
+    {Py_tp_doc, "Java Iterator Object"},
+    {Py_tp_iter, (void*)PyObject_SelfIter},
+    {Py_tp_iternext, (void*)pyjiterator_next},
+    {0, NULL},
+};
+
+PyType_Spec PyJIterator_Spec = {
+    "pemja.PyJIterator", /* name */
+    sizeof(PyJObject),   /* basicsize */
+    0,                   /* itemsize */
+    Py_TPFLAGS_DEFAULT,  /* flags */
+    pyjiterator_slots,   /* slots */
 };
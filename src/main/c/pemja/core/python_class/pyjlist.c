@@ -132,55 +132,24 @@ static PyObject* pyjlist_inplace_repeat(PyObject* self, Py_ssize_t n) {
   return self;
 }
 
-static PySequenceMethods pyjlist_as_sequence = {
-    pyjlist_len,            /* sq_length */
-    pyjlist_concat,         /* sq_concat */
-    pyjlist_repeat,         /* sq_repeat */
-    pyjlist_item,           /* sq_item */
-    0,                      /* sq_slice */
-    pyjlist_ass_item,       /* sq_ass_item */
-    0,                      /* sq_ass_slice */
-    pyjlist_contains,       /* sq_contains */
-    pyjlist_inplace_concat, /* sq_inplace_concat */
-    pyjlist_inplace_repeat, /* sq_inplace_repeat */
+static PyType_Slot pyjlist_slots[] = {
+    {Py_tp_doc, "Java List Object"},
+    {Py_tp_hash, (void*)PyObject_HashNotImplemented},
+    {Py_sq_length, (void*)pyjlist_len},
+    {Py_sq_concat, (void*)pyjlist_concat},
+    {Py_sq_repeat, (void*)pyjlist_repeat},
+    {Py_sq_item, (void*)pyjlist_item},
+    {Py_sq_ass_item, (void*)pyjlist_ass_item},
+    {Py_sq_contains, (void*)pyjlist_contains},
+    {Py_sq_inplace_concat, (void*)pyjlist_inplace_concat},
+    {Py_sq_inplace_repeat, (void*)pyjlist_inplace_repeat},
+    {0, NULL},
 };
 
-PyTypeObject PyJList_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJList", /* tp_name */
-    sizeof(PyJObject),                              /* tp_basicsize */
-    0,                                              /* tp_itemsize */
-    0,                                              /* tp_dealloc */
-    0,                                              /* tp_print */
-    0,                                              /* tp_getattr */
-    0,                                              /* tp_setattr */
-    0,                                              /* tp_reserved */
-    0,                                              /* tp_repr */
-    0,                                              /* tp_as_number */
-    &pyjlist_as_sequence,                           /* tp_as_sequence */
-    0,                                              /* tp_as_mapping */
-    PyObject_HashNotImplemented,                    /* tp_hash */
-    0,                                              /* tp_call */
-    0,                                              /* tp_str */
-    0,                                              /* tp_getattro */
-    0,                                              /* tp_setattro */
-    0,                                              /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,       /* tp_flags */
-    "Java List Object",                             /* tp_doc */
-    0,                                              /* tp_traverse */
-    0,                                              /* tp_clear */
-    0,                                              /* tp_richcompare */
-    0,                                              /* tp_weaklistoffset */
-    0,                                              /* tp_iter */
-    0,                                              /* tp_iternext */
-    0,                                              /* tp_methods */
-    0,                                              /* tp_members */
-    0,                                              /* tp_getset */
-    0,                                              /* tp_base */
-    0,                                              /* tp_dict */
-    0,                                              /* tp_descr_get */
-    0,                                              /* tp_descr_set */
-    0,                                              /* tp_dictoffset */
-    0,                                              /* tp_init */
-    0,                                              /* tp_alloc */
-    0,                                              /* tp_new */
+PyType_Spec PyJList_Spec = {
+    "pemja.PyJList",                          /* name */
+    sizeof(PyJObject),                        /* basicsize */
+    0,                                        /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* flags */
+    pyjlist_slots,                            /* slots */
 };
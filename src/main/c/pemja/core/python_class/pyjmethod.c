@@ -16,7 +16,9 @@
 #include "java_class/JavaClass.h"
 #include "python_class/PythonClass.h"
 
-static int pyjmethod_init(JNIEnv *env, PyJMethodObject *self) {
+/* Resolves the parameter types, modifiers and return type of the method. */
+
+static int pyjmethod_resolve(JNIEnv *env, PyJMethodObject *self) {
   jobjectArray parameters;
   jint modifier;
   jclass returnType;
@@ -33,9 +35,6 @@ static int pyjmethod_init(JNIEnv *env, PyJMethodObject *self) {
     goto EXIT_ERROR;
   }
 
-  self->md_params = (*env)->NewGlobalRef(env, parameters);
-  self->md_params_num = (*env)->GetArrayLength(env, parameters);
-
   modifier = JavaMethod_getModifiers(env, self->md);
 
   if (JcpJavaErr_Throw(env)) {
@@ -54,7 +53,29 @@ static int pyjmethod_init(JNIEnv *env, PyJMethodObject *self) {
     goto EXIT_ERROR;
   }
 
+  self->md_is_varargs = JavaMethod_isVarArgs(env, self->md);
+
+  if (JcpJavaErr_Throw(env)) {
+    goto EXIT_ERROR;
+  }
+
+  // short methods marked with @NoGilRelease are called holding the GIL
+  self->md_keeps_gil = JavaClassUtils_isNoGilRelease(env, self->md);
+
+  if (JcpJavaErr_Throw(env)) {
+    goto EXIT_ERROR;
+  }
+
   self->md_return_id = JcpJObject_GetObjectId(env, returnType);
+  if (JCP_IS_OBJECT_ID(self->md_return_id)) {
+    self->md_needs_local_frame = 1;
+  }
+
+  if (JcpPyJMethod_InitParams(env, self, parameters) < 0) {
+    goto EXIT_ERROR;
+  }
+
+  Jcp_STORE_RELEASE(self->md_is_initialized, 1);
 
   (*env)->PopLocalFrame(env, NULL);
   return 0;
@@ -64,37 +85,43 @@ EXIT_ERROR:
   return -1;
 }
 
-static PyObject *pyjmethod_call(PyJMethodObject *self, PyObject *args,
-                                PyObject *kwargs) {
-  PyObject *arg, *pyobject = NULL;
-  PyJObject *instance;
+/* Resolves the method if required, which is deferred to the first call of the
+ * method. */
 
-  JNIEnv *env;
-  jvalue *jargs;
-  Py_ssize_t nargs, input_nargs;
+static int pyjmethod_init(JNIEnv *env, PyJMethodObject *self) {
+  int ret = 0;
 
-  if (kwargs != NULL) {
-    PyErr_SetString(PyExc_RuntimeError,
-                    "Keywords are not supported in calling Java method.");
-    return NULL;
+  if (Jcp_LOAD_ACQUIRE(self->md_is_initialized)) {
+    return 0;
   }
 
-  env = JcpThreadEnv_Get();
+  // threads of free-threaded Python may race on the first call
+  Jcp_BEGIN_CRITICAL_SECTION(self);
+  if (!self->md_is_initialized) {
+    ret = pyjmethod_resolve(env, self);
+  }
+  Jcp_END_CRITICAL_SECTION();
 
-  input_nargs = PyTuple_Size(args);
-  // PyJObject as the first argument.
-  if (self->md_params_num != input_nargs - 1) {
-    jboolean varargs = JavaMethod_isVarArgs(env, self->md);
+  return ret;
+}
 
-    if (JcpJavaErr_Throw(env)) {
-      return NULL;
-    }
+/* Converts the Python arguments of a call to the Java arguments of the method.
+ * The PyJObject is the first of the Python arguments. */
+
+static int pyjmethod_convert_args(JNIEnv *env, PyJMethodObject *self,
+                                  PyObject *args, jvalue *jargs) {
+  PyObject *arg;
+  PyJMethodParam *param;
+  Py_ssize_t nargs, input_nargs;
 
-    if (!varargs || self->md_params_num > input_nargs) {
+  input_nargs = PyTuple_GET_SIZE(args);
+  // PyJObject as the first argument.
+  if (self->md_params_num != input_nargs - 1) {
+    if (!self->md_is_varargs || self->md_params_num > input_nargs) {
       PyErr_Format(PyExc_RuntimeError,
                    "Invalid number of arguments: %i, expected %i for method",
                    input_nargs - 1, self->md_params_num);
-      return NULL;
+      return -1;
     }
 
     nargs = self->md_params_num - 1;
@@ -102,298 +129,478 @@ static PyObject *pyjmethod_call(PyJMethodObject *self, PyObject *args,
     nargs = self->md_params_num;
   }
 
-  arg = PyTuple_GetItem(args, 0);
-  if (!PyJObject_Check(arg)) {
-    PyErr_Format(PyExc_RuntimeError,
-                 "The first argument type must be a Java Object Type");
-  }
-
-  instance = (PyJObject *)arg;
-
-  if ((*env)->PushLocalFrame(env, 16 + self->md_params_num) != 0) {
-    return NULL;
-  }
-
-  if (nargs == input_nargs - 1) {
-    jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * nargs);
-  } else {
-    jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * self->md_params_num);
-  }
-
   for (int i = 0; i < nargs; i++) {
-    arg = PyTuple_GetItem(args, i + 1);
-    jclass paramType = (*env)->GetObjectArrayElement(env, self->md_params, i);
-    jargs[i] = JcpPyObject_AsJValue(env, arg, paramType);
-    (*env)->DeleteLocalRef(env, paramType);
+    arg = PyTuple_GET_ITEM(args, i + 1);
+    param = &self->md_param_types[i];
+    jargs[i] = _JcpPyObject_AsJValue(env, arg, param->type, param->converter);
     if (JcpJavaErr_Throw(env) || PyErr_Occurred()) {
-      goto EXIT_ERROR;
+      return -1;
     }
   }
 
-  if (nargs < self->md_params_num && nargs < input_nargs - 1) {
-    jclass paramType =
-        (*env)->GetObjectArrayElement(env, self->md_params, (jsize)nargs);
-    PyObject *param = PyTuple_GetSlice(args, nargs, input_nargs);
-    jargs[nargs] = JcpPyObject_AsJValue(env, param, paramType);
-    (*env)->DeleteLocalRef(env, paramType);
+  if (nargs < self->md_params_num) {
+    param = &self->md_param_types[nargs];
+    arg = PyTuple_GetSlice(args, nargs, input_nargs);
+    if (!arg) {
+      return -1;
+    }
+    jargs[nargs] = _JcpPyObject_AsJValue(env, arg, param->type,
+                                         param->converter);
+    Py_DECREF(arg);
     if (JcpJavaErr_Throw(env) || PyErr_Occurred()) {
-      goto EXIT_ERROR;
+      return -1;
     }
   }
 
-  switch (self->md_return_id) {
-    case JBOOLEAN_ID: {
-      jboolean object;
+  return 0;
+}
 
-      Py_BEGIN_ALLOW_THREADS
+/* Calls the Java method with the converted arguments. It doesn't touch any
+ * Python object, so it can be called without holding the GIL. */
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticBooleanMethodA(env, instance->clazz,
-                                                  self->md_id, jargs);
-      }
-      else {
-        object = (*env)->CallBooleanMethodA(env, instance->object, self->md_id,
-                                            jargs);
-      }
+static jvalue pyjmethod_invoke(JNIEnv *env, PyJMethodObject *self,
+                               PyJObject *instance, jvalue *jargs) {
+  jvalue result;
 
-      Py_END_ALLOW_THREADS
+  result.j = 0;
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
+  switch (self->md_return_id) {
+    case JBOOLEAN_ID: {
+      if (self->md_is_static) {
+        result.z = (*env)->CallStaticBooleanMethodA(env, instance->clazz,
+                                                    self->md_id, jargs);
+      } else {
+        result.z = (*env)->CallBooleanMethodA(env, instance->object,
+                                              self->md_id, jargs);
       }
-
-      pyobject = JcpPyBool_FromLong((long)object);
       break;
     }
     case JBYTE_ID: {
-      jbyte object;
-
-      Py_BEGIN_ALLOW_THREADS
-
-          if (self->md_is_static) {
-        object = (*env)->CallStaticByteMethodA(env, instance->clazz,
-                                               self->md_id, jargs);
-      }
-      else {
-        object =
+      if (self->md_is_static) {
+        result.b = (*env)->CallStaticByteMethodA(env, instance->clazz,
+                                                 self->md_id, jargs);
+      } else {
+        result.b =
             (*env)->CallByteMethodA(env, instance->object, self->md_id, jargs);
       }
-
-      Py_END_ALLOW_THREADS
-
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
-
-      pyobject = JcpPyInt_FromInt((int)object);
       break;
     }
     case JSHORT_ID: {
-      jshort object;
-
-      Py_BEGIN_ALLOW_THREADS
-
-          if (self->md_is_static) {
-        object = (*env)->CallStaticShortMethodA(env, instance->clazz,
+      if (self->md_is_static) {
+        result.s = (*env)->CallStaticShortMethodA(env, instance->clazz,
+                                                  self->md_id, jargs);
+      } else {
+        result.s =
+            (*env)->CallShortMethodA(env, instance->object, self->md_id, jargs);
+      }
+      break;
+    }
+    case JINT_ID: {
+      if (self->md_is_static) {
+        result.i = (*env)->CallStaticIntMethodA(env, instance->clazz,
                                                 self->md_id, jargs);
+      } else {
+        result.i =
+            (*env)->CallIntMethodA(env, instance->object, self->md_id, jargs);
       }
-      else {
-        object =
-            (*env)->CallShortMethodA(env, instance->object, self->md_id, jargs);
+      break;
+    }
+    case JLONG_ID: {
+      if (self->md_is_static) {
+        result.j = (*env)->CallStaticLongMethodA(env, instance->clazz,
+                                                 self->md_id, jargs);
+      } else {
+        result.j =
+            (*env)->CallLongMethodA(env, instance->object, self->md_id, jargs);
       }
-
-      Py_END_ALLOW_THREADS
-
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
+      break;
+    }
+    case JFLOAT_ID: {
+      if (self->md_is_static) {
+        result.f = (*env)->CallStaticFloatMethodA(env, instance->clazz,
+                                                  self->md_id, jargs);
+      } else {
+        result.f =
+            (*env)->CallFloatMethodA(env, instance->object, self->md_id, jargs);
       }
-
-      pyobject = JcpPyInt_FromInt((int)object);
       break;
     }
-    case JINT_ID: {
-      jint object;
-
-      Py_BEGIN_ALLOW_THREADS
-
-          if (self->md_is_static) {
-        object = (*env)->CallStaticIntMethodA(env, instance->clazz, self->md_id,
-                                              jargs);
+    case JDOUBLE_ID: {
+      if (self->md_is_static) {
+        result.d = (*env)->CallStaticDoubleMethodA(env, instance->clazz,
+                                                   self->md_id, jargs);
+      } else {
+        result.d = (*env)->CallDoubleMethodA(env, instance->object,
+                                             self->md_id, jargs);
       }
-      else {
-        object =
-            (*env)->CallIntMethodA(env, instance->object, self->md_id, jargs);
+      break;
+    }
+    case JVOID_ID: {
+      if (self->md_is_static) {
+        (*env)->CallStaticVoidMethodA(env, instance->clazz, self->md_id, jargs);
+      } else {
+        (*env)->CallVoidMethodA(env, instance->object, self->md_id, jargs);
       }
-
-      Py_END_ALLOW_THREADS
-
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
+      break;
+    }
+    case JSTRING_ID:
+    case JBYTES_ID:
+    case JLIST_ID:
+    case JMAP_ID:
+    case JARRAY_ID:
+    case JOBJECT_ID: {
+      if (self->md_is_static) {
+        result.l = (*env)->CallStaticObjectMethodA(env, instance->clazz,
+                                                   self->md_id, jargs);
+      } else {
+        result.l = (*env)->CallObjectMethodA(env, instance->object,
+                                             self->md_id, jargs);
       }
-
-      pyobject = JcpPyInt_FromInt(object);
       break;
     }
-    case JLONG_ID: {
-      jlong object;
+  }
 
-      Py_BEGIN_ALLOW_THREADS
+  return result;
+}
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticLongMethodA(env, instance->clazz,
-                                               self->md_id, jargs);
-      }
-      else {
-        object =
-            (*env)->CallLongMethodA(env, instance->object, self->md_id, jargs);
-      }
+/* Converts the result of the Java method to a Python object. */
 
-      Py_END_ALLOW_THREADS
+static PyObject *pyjmethod_convert_result(JNIEnv *env, PyJMethodObject *self,
+                                          jvalue result) {
+  switch (self->md_return_id) {
+    case JBOOLEAN_ID:
+      return JcpPyBool_FromLong((long)result.z);
+    case JBYTE_ID:
+      return JcpPyInt_FromInt((int)result.b);
+    case JSHORT_ID:
+      return JcpPyInt_FromInt((int)result.s);
+    case JINT_ID:
+      return JcpPyInt_FromInt(result.i);
+    case JLONG_ID:
+      return JcpPyInt_FromLong(result.j);
+    case JFLOAT_ID:
+      return JcpPyFloat_FromDouble((double)result.f);
+    case JDOUBLE_ID:
+      return JcpPyFloat_FromDouble(result.d);
+    case JVOID_ID:
+      Py_RETURN_NONE;
+    case JSTRING_ID:
+      return JcpPyString_FromJString(env, (jstring)result.l);
+    case JBYTES_ID:
+    case JLIST_ID:
+    case JMAP_ID:
+    case JARRAY_ID:
+    case JOBJECT_ID:
+      return JcpPyObject_FromJObject(env, result.l);
+    default:
+      PyErr_Format(PyExc_TypeError, "Unrecognized object id %d.",
+                   self->md_return_id);
+      return NULL;
+  }
+}
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
+static PyObject *pyjmethod_call(PyJMethodObject *self, PyObject *args,
+                                PyObject *kwargs) {
+  PyObject *arg, *pyobject = NULL;
+  PyJObject *instance;
 
-      pyobject = JcpPyInt_FromLong(object);
-      break;
+  JNIEnv *env;
+  jvalue stack_jargs[JCP_METHOD_STACK_ARGS];
+  jvalue *jargs = stack_jargs;
+  jvalue result;
+
+  if (kwargs != NULL) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "Keywords are not supported in calling Java method.");
+    return NULL;
+  }
+
+  env = JcpThreadEnv_Get();
+
+  if (pyjmethod_init(env, self) < 0) {
+    return NULL;
+  }
+
+  arg = PyTuple_GET_ITEM(args, 0);
+  if (!PyJObject_Check(arg)) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "The first argument type must be a Java Object Type");
+    return NULL;
+  }
+
+  instance = (PyJObject *)arg;
+
+  // methods only taking and returning primitives create no local references
+  if (self->md_needs_local_frame &&
+      (*env)->PushLocalFrame(env, 16 + self->md_params_num) != 0) {
+    JcpJavaErr_Throw(env);
+    return NULL;
+  }
+
+  if (self->md_params_num > JCP_METHOD_STACK_ARGS) {
+    jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * self->md_params_num);
+    if (!jargs) {
+      PyErr_NoMemory();
+      goto EXIT_ERROR;
     }
-    case JFLOAT_ID: {
-      jfloat object;
+  }
 
-      Py_BEGIN_ALLOW_THREADS
+  if (pyjmethod_convert_args(env, self, args, jargs) < 0) {
+    goto EXIT_ERROR;
+  }
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticFloatMethodA(env, instance->clazz,
-                                                self->md_id, jargs);
-      }
-      else {
-        object =
-            (*env)->CallFloatMethodA(env, instance->object, self->md_id, jargs);
-      }
+  if (self->md_keeps_gil) {
+    result = pyjmethod_invoke(env, self, instance, jargs);
+  } else {
+    Py_BEGIN_ALLOW_THREADS
+    result = pyjmethod_invoke(env, self, instance, jargs);
+    Py_END_ALLOW_THREADS
+  }
 
-      Py_END_ALLOW_THREADS
+  if (JcpJavaErr_Throw(env)) {
+    goto EXIT_ERROR;
+  }
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
+  pyobject = pyjmethod_convert_result(env, self, result);
 
-      pyobject = JcpPyFloat_FromDouble((double)object);
+EXIT_ERROR:
+  if (jargs != stack_jargs) {
+    PyMem_Free(jargs);
+  }
+  if (self->md_needs_local_frame) {
+    (*env)->PopLocalFrame(env, NULL);
+  }
+  return pyobject;
+}
+
+/* Calls the Java method with every converted arguments until an exception is
+ * thrown. */
+
+static void pyjmethod_invoke_all(JNIEnv *env, PyJMethodObject *self,
+                                 PyJObject *instance, jvalue *jargs,
+                                 Py_ssize_t nparams, jvalue *results,
+                                 Py_ssize_t len) {
+  for (Py_ssize_t i = 0; i < len; i++) {
+    results[i] = pyjmethod_invoke(env, self, instance, jargs + i * nparams);
+    if ((*env)->ExceptionCheck(env)) {
       break;
     }
-    case JDOUBLE_ID: {
-      jdouble object;
+  }
+}
 
-      Py_BEGIN_ALLOW_THREADS
+/* Calls the method with every argument tuple of a chunk. The arguments are
+ * converted first, then the Java method is called for all of them with the GIL
+ * released only once, and the results are set to the list from `start`. */
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticDoubleMethodA(env, instance->clazz,
-                                                 self->md_id, jargs);
-      }
-      else {
-        object = (*env)->CallDoubleMethodA(env, instance->object, self->md_id,
-                                           jargs);
-      }
+static int pyjmethod_call_chunk(JNIEnv *env, PyJMethodObject *self,
+                                PyObject **calls, Py_ssize_t len,
+                                PyObject *list, Py_ssize_t start) {
+  PyObject *pyobject;
+  PyJObject *instance;
+  jvalue *jargs, *results;
+  Py_ssize_t i, nparams;
+  int ret = -1;
 
-      Py_END_ALLOW_THREADS
+  nparams = self->md_params_num > 0 ? self->md_params_num : 1;
+  if ((*env)->PushLocalFrame(env, 16 + len * (nparams + 1)) != 0) {
+    JcpJavaErr_Throw(env);
+    return -1;
+  }
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
+  jargs = (jvalue *)PyMem_Malloc(sizeof(jvalue) * (nparams + 1) * len);
+  if (!jargs) {
+    PyErr_NoMemory();
+    (*env)->PopLocalFrame(env, NULL);
+    return -1;
+  }
+  results = jargs + nparams * len;
 
-      pyobject = JcpPyFloat_FromDouble((double)object);
-      break;
+  for (i = 0; i < len; i++) {
+    if (pyjmethod_convert_args(env, self, calls[i], jargs + i * nparams) < 0) {
+      goto EXIT;
     }
-    case JSTRING_ID: {
-      jobject object;
+  }
 
-      Py_BEGIN_ALLOW_THREADS
+  instance = (PyJObject *)PyTuple_GET_ITEM(calls[0], 0);
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticObjectMethodA(env, instance->clazz,
-                                                 self->md_id, jargs);
-      }
-      else {
-        object = (*env)->CallObjectMethodA(env, instance->object, self->md_id,
-                                           jargs);
-      }
+  if (self->md_keeps_gil) {
+    pyjmethod_invoke_all(env, self, instance, jargs, nparams, results, len);
+  } else {
+    Py_BEGIN_ALLOW_THREADS
+    pyjmethod_invoke_all(env, self, instance, jargs, nparams, results, len);
+    Py_END_ALLOW_THREADS
+  }
 
-      Py_END_ALLOW_THREADS
+  if (JcpJavaErr_Throw(env)) {
+    goto EXIT;
+  }
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
+  for (i = 0; i < len; i++) {
+    pyobject = pyjmethod_convert_result(env, self, results[i]);
+    if (!pyobject) {
+      goto EXIT;
+    }
+    PyList_SET_ITEM(list, start + i, pyobject);
+  }
 
-      pyobject = JcpPyString_FromJString(env, (jstring)object);
-      break;
+  ret = 0;
+
+EXIT:
+  PyMem_Free(jargs);
+  (*env)->PopLocalFrame(env, NULL);
+  return ret;
+}
+
+/* Creates the arguments of a call with the PyJObject as the first one. */
+
+static PyObject *pyjmethod_bind_args(PyObject *instance, PyObject *item,
+                                     int unpack) {
+  PyObject *args, *call;
+  Py_ssize_t nargs;
+
+  if (!unpack) {
+    return PyTuple_Pack(2, instance, item);
+  }
+
+  args = PySequence_Tuple(item);
+  if (!args) {
+    return NULL;
+  }
+
+  nargs = PyTuple_GET_SIZE(args);
+  call = PyTuple_New(nargs + 1);
+  if (call) {
+    Py_INCREF(instance);
+    PyTuple_SET_ITEM(call, 0, instance);
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+      Py_INCREF(PyTuple_GET_ITEM(args, i));
+      PyTuple_SET_ITEM(call, i + 1, PyTuple_GET_ITEM(args, i));
     }
-    case JVOID_ID: {
-      Py_BEGIN_ALLOW_THREADS
+  }
 
-          if (self->md_is_static) {
-        (*env)->CallStaticVoidMethodA(env, instance->clazz, self->md_id, jargs);
-      }
-      else {
-        (*env)->CallVoidMethodA(env, instance->object, self->md_id, jargs);
-      }
+  Py_DECREF(args);
+  return call;
+}
 
-      Py_END_ALLOW_THREADS
+/* Calls a bound Java method with every item of the iterable and returns the
+ * results in a list. The items are the arguments themselves, or unpacked into
+ * the arguments if `unpack` is set. */
 
-          if (JcpJavaErr_Throw(env)) {
-        goto EXIT_ERROR;
-      }
+PyObject *JcpPyJMethod_Map(PyObject *callable, PyObject *iterable,
+                           int unpack) {
+  PyObject *func, *instance, *items, *call, *list = NULL;
+  PyObject *calls[JCP_METHOD_MAP_CHUNK_SIZE];
+  PyJMethodObject *method, *chunk_method = NULL;
+  Py_ssize_t len, chunk_start = 0, chunk_len = 0;
+  int ret;
 
-      pyobject = Py_None;
-      Py_INCREF(pyobject);
-      break;
+  JNIEnv *env;
+
+  if (!PyMethod_Check(callable) ||
+      !(PyJMethod_Check(PyMethod_GET_FUNCTION(callable)) ||
+        PyJMultiMethod_Check(PyMethod_GET_FUNCTION(callable))) ||
+      !PyJObject_Check(PyMethod_GET_SELF(callable))) {
+    PyErr_Format(PyExc_TypeError,
+                 "Expected a method of a Java object, but got '%s'.",
+                 Py_TYPE(callable)->tp_name);
+    return NULL;
+  }
+
+  func = PyMethod_GET_FUNCTION(callable);
+  instance = PyMethod_GET_SELF(callable);
+
+  items = PySequence_Fast(iterable, "The arguments must be iterable.");
+  if (!items) {
+    return NULL;
+  }
+
+  len = PySequence_Fast_GET_SIZE(items);
+  list = PyList_New(len);
+  if (!list) {
+    Py_DECREF(items);
+    return NULL;
+  }
+
+  env = JcpThreadEnv_Get();
+
+  for (Py_ssize_t i = 0; i < len; i++) {
+    call = pyjmethod_bind_args(instance, PySequence_Fast_GET_ITEM(items, i),
+                               unpack);
+    if (!call) {
+      goto EXIT_ERROR;
     }
-    case JBYTES_ID:
-    case JLIST_ID:
-    case JMAP_ID:
-    case JARRAY_ID:
-    case JOBJECT_ID: {
-      jobject object;
 
-      Py_BEGIN_ALLOW_THREADS
+    // the overload is resolved once for the arguments of the same types
+    if (PyJMultiMethod_Check(func)) {
+      method = JcpPyJMultiMethod_Resolve((PyJMultiMethodObject *)func, call);
+    } else {
+      method = (PyJMethodObject *)func;
+    }
 
-          if (self->md_is_static) {
-        object = (*env)->CallStaticObjectMethodA(env, instance->clazz,
-                                                 self->md_id, jargs);
-      }
-      else {
-        object = (*env)->CallObjectMethodA(env, instance->object, self->md_id,
-                                           jargs);
-      }
+    if (!method || pyjmethod_init(env, method) < 0) {
+      Py_DECREF(call);
+      goto EXIT_ERROR;
+    }
 
-      Py_END_ALLOW_THREADS
+    // the calls of another overload start a new chunk
+    if (chunk_len > 0 &&
+        (method != chunk_method || chunk_len == JCP_METHOD_MAP_CHUNK_SIZE)) {
+      ret = pyjmethod_call_chunk(env, chunk_method, calls, chunk_len, list,
+                                 chunk_start);
+      for (Py_ssize_t j = 0; j < chunk_len; j++) {
+        Py_DECREF(calls[j]);
+      }
+      chunk_start += chunk_len;
+      chunk_len = 0;
 
-          if (JcpJavaErr_Throw(env)) {
+      if (ret < 0) {
+        Py_DECREF(call);
         goto EXIT_ERROR;
       }
+    }
 
-      pyobject = JcpPyObject_FromJObject(env, object);
-      break;
+    chunk_method = method;
+    calls[chunk_len++] = call;
+  }
+
+  if (chunk_len > 0) {
+    ret = pyjmethod_call_chunk(env, chunk_method, calls, chunk_len, list,
+                               chunk_start);
+    for (Py_ssize_t j = 0; j < chunk_len; j++) {
+      Py_DECREF(calls[j]);
     }
-    default: {
-      PyErr_Format(PyExc_TypeError, "Unrecognized object id %d.",
-                   self->md_return_id);
+    chunk_len = 0;
 
-      pyobject = NULL;
+    if (ret < 0) {
+      goto EXIT_ERROR;
     }
   }
 
+  Py_DECREF(items);
+  return list;
+
 EXIT_ERROR:
-  PyMem_Free(jargs);
-  (*env)->PopLocalFrame(env, NULL);
-  return pyobject;
+  for (Py_ssize_t j = 0; j < chunk_len; j++) {
+    Py_DECREF(calls[j]);
+  }
+  Py_DECREF(list);
+  Py_DECREF(items);
+  return NULL;
 }
 
 static void pyjmethod_dealloc(PyJMethodObject *self) {
+  PyTypeObject *type = Py_TYPE(self);
   JNIEnv *env = JcpThreadEnv_Get();
 
   if (env) {
-    if (self->md_params) {
-      (*env)->DeleteGlobalRef(env, self->md_params);
-      self->md_params = NULL;
+    if (self->md_param_types) {
+      for (int i = 0; i < self->md_params_num; i++) {
+        if (self->md_param_types[i].type) {
+          (*env)->DeleteGlobalRef(env, self->md_param_types[i].type);
+        }
+      }
+      PyMem_Free(self->md_param_types);
+      self->md_param_types = NULL;
     }
     if (self->md) {
       (*env)->DeleteGlobalRef(env, self->md);
@@ -404,6 +611,7 @@ static void pyjmethod_dealloc(PyJMethodObject *self) {
   Py_CLEAR(self->md_name);
 
   PyObject_Del(self);
+  Py_DECREF(type);
 }
 
 PyJMethodObject *JcpPyJMethod_New(JNIEnv *env, jobject method) {
@@ -411,10 +619,6 @@ PyJMethodObject *JcpPyJMethod_New(JNIEnv *env, jobject method) {
 
   PyJMethodObject *self;
 
-  if (PyType_Ready(&PyJMethod_Type) < 0) {
-    return NULL;
-  }
-
   self = PyObject_NEW(PyJMethodObject, &PyJMethod_Type);
 
   methodName = (jstring)JavaMember_getName(env, method);
@@ -422,34 +626,74 @@ PyJMethodObject *JcpPyJMethod_New(JNIEnv *env, jobject method) {
   self->md = (*env)->NewGlobalRef(env, method);
   self->md_id = NULL;
   self->md_name = JcpPyString_FromJString(env, methodName);
-  self->md_params = NULL;
   self->md_params_num = -1;
+  self->md_param_types = NULL;
+  self->md_is_varargs = 0;
+  self->md_needs_local_frame = 0;
   self->md_is_static = -1;
+  self->md_keeps_gil = 0;
   self->md_return_id = -1;
+  self->md_is_initialized = 0;
 
   (*env)->DeleteLocalRef(env, methodName);
 
-  if (pyjmethod_init(env, self) < 0) {
-    Py_DECREF((PyObject *)self);
-    self = NULL;
+  return self;
+}
+
+/* Precomputes the descriptors of the params of the method. */
+
+int JcpPyJMethod_InitParams(JNIEnv *env, PyJMethodObject *self,
+                            jobjectArray parameters) {
+  PyJMethodParam *param;
+  jclass paramType;
+
+  self->md_params_num = (*env)->GetArrayLength(env, parameters);
+  self->md_param_types = (PyJMethodParam *)PyMem_Calloc(
+      self->md_params_num > 0 ? self->md_params_num : 1,
+      sizeof(PyJMethodParam));
+
+  if (!self->md_param_types) {
+    PyErr_NoMemory();
+    return -1;
   }
 
-  return self;
+  for (int i = 0; i < self->md_params_num; i++) {
+    param = &self->md_param_types[i];
+    paramType = (jclass)(*env)->GetObjectArrayElement(env, parameters, i);
+
+    param->type = (*env)->NewGlobalRef(env, paramType);
+    param->type_id = JcpJObject_GetObjectId(env, paramType);
+    param->converter = JcpPyObject_GetJValueConverter(param->type_id);
+
+    (*env)->DeleteLocalRef(env, paramType);
+
+    if (JcpJavaErr_Throw(env)) {
+      return -1;
+    }
+
+    if (JCP_IS_OBJECT_ID(param->type_id)) {
+      self->md_needs_local_frame = 1;
+    }
+  }
+
+  return 0;
 }
 
 int JcpPyJMethodMatch(PyJMethodObject *self, PyObject *args) {
   PyObject *arg;
+  PyJMethodParam *param;
 
   JNIEnv *env;
-  jclass paramType;
   int nargs;
 
   env = JcpThreadEnv_Get();
 
-  if (PyTuple_Size(args) - 1 != self->md_params_num) {
-    jboolean varargs = JavaMethod_isVarArgs(env, self->md);
+  if (pyjmethod_init(env, self) < 0) {
+    return 0;
+  }
 
-    if (!varargs) {
+  if (PyTuple_Size(args) - 1 != self->md_params_num) {
+    if (!self->md_is_varargs || self->md_params_num > PyTuple_Size(args)) {
       return 0;
     }
 
@@ -474,11 +718,10 @@ int JcpPyJMethodMatch(PyJMethodObject *self, PyObject *args) {
 
   for (int i = 0; i < nargs; i++) {
     arg = PyTuple_GetItem(args, i + 1);
-    paramType = (jclass)(*env)->GetObjectArrayElement(env, self->md_params, i);
-
-    int match_degree = JcpPyObject_match(env, arg, paramType);
+    param = &self->md_param_types[i];
 
-    (*env)->DeleteLocalRef(env, paramType);
+    int match_degree =
+        JcpPyObject_matchWithId(env, arg, param->type, param->type_id);
 
     if (!match_degree) {
       return 0;
@@ -490,42 +733,31 @@ int JcpPyJMethodMatch(PyJMethodObject *self, PyObject *args) {
   return total_match_degree;
 }
 
-PyTypeObject PyJMethod_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJMethod", /* tp_name */
-    sizeof(PyJMethodObject),                          /* tp_basicsize */
-    0,                                                /* tp_itemsize */
-    (destructor)pyjmethod_dealloc,                    /* tp_dealloc */
-    0,                                                /* tp_print */
-    0,                                                /* tp_getattr */
-    0,                                                /* tp_setattr */
-    0,                                                /* tp_reserved */
-    0,                                                /* tp_repr */
-    0,                                                /* tp_as_number */
-    0,                                                /* tp_as_sequence */
-    0,                                                /* tp_as_mapping */
-    0,                                                /* tp_hash */
-    (ternaryfunc)pyjmethod_call,                      /* tp_call */
-    0,                                                /* tp_str */
-    0,                                                /* tp_getattro */
-    0,                                                /* tp_setattro */
-    0,                                                /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                               /* tp_flags */
-    "Java Method Object",                             /* tp_doc */
-    0,                                                /* tp_traverse */
-    0,                                                /* tp_clear */
-    0,                                                /* tp_richcompare */
-    0,                                                /* tp_weaklistoffset */
-    0,                                                /* tp_iter */
-    0,                                                /* tp_iternext */
-    0,                                                /* tp_methods */
-    0,                                                /* tp_members */
-    0,                                                /* tp_getset */
-    0,                                                /* tp_base */
-    0,                                                /* tp_dict */
-    0,                                                /* tp_descr_get */
-    0,                                                /* tp_descr_set */
-    0,                                                /* tp_dictoffset */
-    0,                                                /* tp_init */
-    0,                                                /* tp_alloc */
-    0,                                                /* tp_new */
+/* Binds the method to a PyJObject when it is installed into the Python type of
+ * a Java class. */
+
+static PyObject *pyjmethod_descr_get(PyObject *self, PyObject *obj,
+                                     PyObject *type) {
+  if (obj == NULL || obj == Py_None) {
+    Py_INCREF(self);
+    return self;
+  }
+
+  return PyMethod_New(self, obj);
+}
+
+static PyType_Slot pyjmethod_slots[] = {
+    {Py_tp_doc, "Java Method Object"},
+    {Py_tp_dealloc, (void *)pyjmethod_dealloc},
+    {Py_tp_call, (void *)pyjmethod_call},
+    {Py_tp_descr_get, (void *)pyjmethod_descr_get},
+    {0, NULL},
+};
+
+PyType_Spec PyJMethod_Spec = {
+    "pemja.PyJMethod",                                 /* name */
+    sizeof(PyJMethodObject),                           /* basicsize */
+    0,                                                 /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_METHOD_DESCRIPTOR, /* flags */
+    pyjmethod_slots,                                   /* slots */
 };
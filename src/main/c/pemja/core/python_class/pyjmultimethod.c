@@ -17,6 +17,9 @@
 #include "python_class/PythonClass.h"
 
 static int multi_method_init(PyJMultiMethodObject *self) {
+  memset(self->cache, 0, sizeof(self->cache));
+  self->cache_next = 0;
+
   self->methods = PyList_New(0);
 
   if (!self->methods) {
@@ -29,19 +32,103 @@ static int multi_method_init(PyJMultiMethodObject *self) {
   return 0;
 }
 
-static PyObject *multi_method_call(PyJMultiMethodObject *self, PyObject *args,
-                                   PyObject *kwargs) {
-  Py_ssize_t method_num;
+/* Overload resolution only depends on the Python types of the arguments and
+ * the Java classes of the PyJObject arguments, so the matched method is cached
+ * by them to skip scoring every overload on the next calls. */
 
-  PyJMethodObject *method;
-  PyObject *matched_method = NULL;
+static PyJMethodObject *multi_method_cache_get(JNIEnv *env,
+                                               PyJMultiMethodObject *self,
+                                               PyObject *args) {
+  PyJMultiMethodCacheEntry *entry;
+  PyObject *arg;
+  Py_ssize_t nargs, i;
 
-  if (kwargs != NULL) {
-    PyErr_SetString(PyExc_RuntimeError,
-                    "Keywords are not supported in calling Java method.");
-    return NULL;
+  // PyJObject as the first argument.
+  nargs = PyTuple_GET_SIZE(args) - 1;
+
+  for (int n = 0; n < JCP_MULTI_METHOD_CACHE_SIZE; n++) {
+    entry = &self->cache[n];
+    if (!entry->method || entry->nargs != nargs) {
+      continue;
+    }
+
+    for (i = 0; i < nargs; i++) {
+      arg = PyTuple_GET_ITEM(args, i + 1);
+      if (Py_TYPE(arg) != entry->types[i]) {
+        break;
+      }
+      if (entry->classes[i] &&
+          !(*env)->IsSameObject(env, ((PyJObject *)arg)->clazz,
+                                entry->classes[i])) {
+        break;
+      }
+    }
+
+    if (i == nargs) {
+      return entry->method;
+    }
+  }
+
+  return NULL;
+}
+
+static void multi_method_cache_clear(JNIEnv *env,
+                                     PyJMultiMethodCacheEntry *entry) {
+  for (Py_ssize_t i = 0; i < entry->nargs; i++) {
+    Py_CLEAR(entry->types[i]);
+    if (entry->classes[i]) {
+      (*env)->DeleteGlobalRef(env, entry->classes[i]);
+      entry->classes[i] = NULL;
+    }
   }
 
+  entry->method = NULL;
+  entry->nargs = 0;
+}
+
+static void multi_method_cache_put(JNIEnv *env, PyJMultiMethodObject *self,
+                                   PyObject *args, PyJMethodObject *method) {
+  PyJMultiMethodCacheEntry *entry;
+  PyObject *arg;
+  Py_ssize_t nargs;
+
+  nargs = PyTuple_GET_SIZE(args) - 1;
+  if (nargs > JCP_MULTI_METHOD_CACHE_MAX_ARGS) {
+    return;
+  }
+
+  entry = &self->cache[self->cache_next];
+  self->cache_next = (self->cache_next + 1) % JCP_MULTI_METHOD_CACHE_SIZE;
+
+  multi_method_cache_clear(env, entry);
+
+  for (Py_ssize_t i = 0; i < nargs; i++) {
+    arg = PyTuple_GET_ITEM(args, i + 1);
+    entry->types[i] = Py_TYPE(arg);
+    Py_INCREF(entry->types[i]);
+    if (PyJObject_Check(arg)) {
+      entry->classes[i] = (*env)->NewGlobalRef(env, ((PyJObject *)arg)->clazz);
+    } else {
+      entry->classes[i] = NULL;
+    }
+  }
+
+  entry->nargs = nargs;
+  // the methods are never removed from the list, borrowing is safe
+  entry->method = method;
+}
+
+/* Resolves the overload matching the arguments best. Returns a borrowed
+ * reference. */
+
+PyJMethodObject *JcpPyJMultiMethod_Resolve(PyJMultiMethodObject *self,
+                                           PyObject *args) {
+  Py_ssize_t method_num;
+  JNIEnv *env;
+
+  PyJMethodObject *method;
+  PyJMethodObject *matched_method = NULL;
+
   method_num = PyList_Size(self->methods);
 
   if (self->methods == NULL || method_num == 0) {
@@ -50,40 +137,76 @@ static PyObject *multi_method_call(PyJMultiMethodObject *self, PyObject *args,
     return NULL;
   }
 
+  env = JcpThreadEnv_Get();
+
+  // the threads of the Main Interpreter share the methods, which free-threaded
+  // Python doesn't serialize
+  Jcp_BEGIN_CRITICAL_SECTION(self);
+  method = multi_method_cache_get(env, self, args);
+  Jcp_END_CRITICAL_SECTION();
+  if (method) {
+    return method;
+  }
+
   int max_match_degree = 0;
   for (int i = 0; i < method_num; i++) {
     method = (PyJMethodObject *)PyList_GetItem(self->methods, i);
     int match_degree = JcpPyJMethodMatch(method, args);
 
     if (match_degree > max_match_degree) {
-      matched_method = (PyObject *)method;
+      matched_method = method;
       max_match_degree = match_degree;
     }
   }
 
   if (matched_method) {
-    return PyObject_Call(matched_method, args, kwargs);
+    Jcp_BEGIN_CRITICAL_SECTION(self);
+    multi_method_cache_put(env, self, args, matched_method);
+    Jcp_END_CRITICAL_SECTION();
+    return matched_method;
   } else {
     PyErr_SetString(PyExc_RuntimeError, "There are no matched Java Methods.");
     return NULL;
   }
 }
 
+static PyObject *multi_method_call(PyJMultiMethodObject *self, PyObject *args,
+                                   PyObject *kwargs) {
+  PyJMethodObject *method;
+
+  if (kwargs != NULL) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "Keywords are not supported in calling Java method.");
+    return NULL;
+  }
+
+  method = JcpPyJMultiMethod_Resolve(self, args);
+  if (!method) {
+    return NULL;
+  }
+
+  return PyObject_Call((PyObject *)method, args, kwargs);
+}
+
 static void multi_method_dealloc(PyJMultiMethodObject *self) {
+  PyTypeObject *type = Py_TYPE(self);
+  JNIEnv *env = JcpThreadEnv_Get();
+
+  for (int i = 0; i < JCP_MULTI_METHOD_CACHE_SIZE; i++) {
+    multi_method_cache_clear(env, &self->cache[i]);
+  }
+
   if (self->methods) {
     Py_CLEAR(self->methods);
   }
 
   PyObject_Del(self);
+  Py_DECREF(type);
 }
 
 PyJMultiMethodObject *JcpPyJMultiMethod_New() {
   PyJMultiMethodObject *self;
 
-  if (PyType_Ready(&PyJMultiMethod_Type) < 0) {
-    return NULL;
-  }
-
   self = PyObject_NEW(PyJMultiMethodObject, &PyJMultiMethod_Type);
 
   if (multi_method_init(self) < 0) {
@@ -99,42 +222,31 @@ int JcpPyJMultiMethod_Append(PyJMultiMethodObject *self,
   return PyList_Append(self->methods, (PyObject *)method);
 }
 
-PyTypeObject PyJMultiMethod_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJMultiMethod", /* tp_name */
-    sizeof(PyJMultiMethodObject),                          /* tp_basicsize */
-    0,                                                     /* tp_itemsize */
-    (destructor)multi_method_dealloc,                      /* tp_dealloc */
-    0,                                                     /* tp_print */
-    0,                                                     /* tp_getattr */
-    0,                                                     /* tp_setattr */
-    0,                                                     /* tp_reserved */
-    0,                                                     /* tp_repr */
-    0,                                                     /* tp_as_number */
-    0,                                                     /* tp_as_sequence */
-    0,                                                     /* tp_as_mapping */
-    0,                                                     /* tp_hash */
-    (ternaryfunc)multi_method_call,                        /* tp_call */
-    0,                                                     /* tp_str */
-    0,                                                     /* tp_getattro */
-    0,                                                     /* tp_setattro */
-    0,                                                     /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT,                                    /* tp_flags */
-    "Java Multi Methods",                                  /* tp_doc */
-    0,                                                     /* tp_traverse */
-    0,                                                     /* tp_clear */
-    0,                                                     /* tp_richcompare */
-    0, /* tp_weaklistoffset */
-    0, /* tp_iter */
-    0, /* tp_iternext */
-    0, /* tp_methods */
-    0, /* tp_members */
-    0, /* tp_getset */
-    0, /* tp_base */
-    0, /* tp_dict */
-    0, /* tp_descr_get */
-    0, /* tp_descr_set */
-    0, /* tp_dictoffset */
-    0, /* tp_init */
-    0, /* tp_alloc */
-    0, /* tp_new */
+/* Binds the methods to a PyJObject when they are installed into the Python
+ * type of a Java class. */
+
+static PyObject *multi_method_descr_get(PyObject *self, PyObject *obj,
+                                        PyObject *type) {
+  if (obj == NULL || obj == Py_None) {
+    Py_INCREF(self);
+    return self;
+  }
+
+  return PyMethod_New(self, obj);
+}
+
+static PyType_Slot pyjmultimethod_slots[] = {
+    {Py_tp_doc, "Java Multi Methods"},
+    {Py_tp_dealloc, (void *)multi_method_dealloc},
+    {Py_tp_call, (void *)multi_method_call},
+    {Py_tp_descr_get, (void *)multi_method_descr_get},
+    {0, NULL},
+};
+
+PyType_Spec PyJMultiMethod_Spec = {
+    "pemja.PyJMultiMethod",                            /* name */
+    sizeof(PyJMultiMethodObject),                      /* basicsize */
+    0,                                                 /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_METHOD_DESCRIPTOR, /* flags */
+    pyjmultimethod_slots,                              /* slots */
 };
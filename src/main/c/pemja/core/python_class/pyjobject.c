@@ -17,15 +17,7 @@
 #include "python_class/PythonClass.h"
 
 static int pyjobject_init(JNIEnv *env, PyJObject *self) {
-  int len;
-  JcpThread *jcpThread;
-
   jstring className;
-  jobjectArray methods, fields;
-  jobject method, field;
-
-  PyObject *cachedAttrs, *cachedMethod;
-  PyJMultiMethodObject *multi_methods;
 
   if ((*env)->PushLocalFrame(env, 16) != 0) {
     return -1;
@@ -37,114 +29,167 @@ static int pyjobject_init(JNIEnv *env, PyJObject *self) {
   }
 
   self->class_name = JcpPyString_FromJString(env, className);
-  jcpThread = JcpThread_Get();
 
-  if (jcpThread->name_to_attrs == NULL) {
-    jcpThread->name_to_attrs = PyDict_New();
+  // the methods and fields are resolved lazily on the first access by name
+  self->attr = JcpClassAttrs_Get(env, self->clazz, self->class_name);
+  if (!self->attr) {
+    goto EXIT_ERROR;
   }
 
-  cachedAttrs = PyDict_GetItem(jcpThread->name_to_attrs, self->class_name);
+  (*env)->PopLocalFrame(env, NULL);
+  return 0;
 
-  if (cachedAttrs == NULL) {
-    cachedAttrs = PyDict_New();
+EXIT_ERROR:
+  (*env)->PopLocalFrame(env, NULL);
+  return -1;
+}
 
-    // cache methods
-    methods = JavaClass_getMethods(env, self->clazz);
-    len = (*env)->GetArrayLength(env, methods);
+/* Resolves the public methods or field of the given name and caches it into
+ * the attributes of the class. A field takes precedence over methods of the
+ * same name. Py_None is cached if the class has no such member. Returns a
+ * borrowed reference. */
 
-    for (int i = 0; i < len; i++) {
-      method = (*env)->GetObjectArrayElement(env, methods, i);
-      PyJMethodObject *pyjmethod = JcpPyJMethod_New(env, method);
-      (*env)->DeleteLocalRef(env, method);
+static PyObject *pyjobject_resolve_attr(jclass clazz, PyObject *attrs,
+                                        PyObject *name) {
+  JNIEnv *env;
+  jstring memberName;
+  jobjectArray methods;
+  jobject member;
+  int len;
 
-      if (!pyjmethod) {
-        continue;
-      }
+  PyObject *attr = NULL;
+  PyJMethodObject *pyjmethod;
 
-      if (pyjmethod->md_name) {
-        cachedMethod = PyDict_GetItem(cachedAttrs, pyjmethod->md_name);
-        if (cachedMethod == NULL) {
-          if (PyDict_SetItem(cachedAttrs, pyjmethod->md_name,
-                             (PyObject *)pyjmethod) < 0) {
-            Py_DECREF(pyjmethod);
-            goto EXIT_ERROR;
-          }
-        } else {
-          if (PyJMethod_Check(cachedMethod)) {
-            multi_methods = JcpPyJMultiMethod_New();
-            if (JcpPyJMultiMethod_Append(multi_methods,
-                                         (PyJMethodObject *)cachedMethod) < 0) {
-              Py_DECREF(pyjmethod);
-              Py_DECREF(multi_methods);
-              goto EXIT_ERROR;
-            }
-
-            if (PyDict_SetItem(cachedAttrs, pyjmethod->md_name,
-                               (PyObject *)multi_methods) < 0) {
-              Py_DECREF(pyjmethod);
-              Py_DECREF(multi_methods);
-              goto EXIT_ERROR;
-            }
-          } else {
-            multi_methods = (PyJMultiMethodObject *)cachedMethod;
-          }
-
-          if (JcpPyJMultiMethod_Append(multi_methods, pyjmethod) < 0) {
-            Py_DECREF(pyjmethod);
-            Py_DECREF(multi_methods);
-            goto EXIT_ERROR;
-          }
-        }
-      }
+  env = JcpThreadEnv_Get();
 
-      Py_DECREF(pyjmethod);
-    }
-    (*env)->DeleteLocalRef(env, methods);
+  if ((*env)->PushLocalFrame(env, 16) != 0) {
+    JcpJavaErr_Throw(env);
+    return NULL;
+  }
 
-    // cache fields
-    fields = JavaClass_getFields(env, self->clazz);
-    len = (*env)->GetArrayLength(env, fields);
+  memberName = JcpPyString_AsJString(env, name);
+  if (!memberName) {
+    goto EXIT;
+  }
 
-    for (int i = 0; i < len; i++) {
-      field = (*env)->GetObjectArrayElement(env, fields, i);
-      PyJFieldObject *pyjfield = JcpPyJField_New(env, field);
-      (*env)->DeleteLocalRef(env, field);
+  member = JavaClassUtils_getField(env, clazz, memberName);
+  if (JcpJavaErr_Throw(env)) {
+    goto EXIT;
+  }
 
-      if (!pyjfield) {
-        continue;
-      }
+  if (member) {
+    attr = (PyObject *)JcpPyJField_New(env, member);
+    goto CACHE;
+  }
+
+  methods = JavaClassUtils_getMethods(env, clazz, memberName);
+  if (JcpJavaErr_Throw(env) || !methods) {
+    goto EXIT;
+  }
+
+  len = (*env)->GetArrayLength(env, methods);
 
-      if (pyjfield->fd_name) {
-        if (PyDict_SetItem(cachedAttrs, pyjfield->fd_name,
-                           (PyObject *)pyjfield) < 0) {
-          Py_DECREF(pyjfield);
-          goto EXIT_ERROR;
-        }
+  if (len == 0) {
+    attr = Py_None;
+    Py_INCREF(attr);
+  } else if (len == 1) {
+    member = (*env)->GetObjectArrayElement(env, methods, 0);
+    attr = (PyObject *)JcpPyJMethod_New(env, member);
+  } else {
+    attr = (PyObject *)JcpPyJMultiMethod_New();
+
+    for (int i = 0; attr && i < len; i++) {
+      member = (*env)->GetObjectArrayElement(env, methods, i);
+      pyjmethod = JcpPyJMethod_New(env, member);
+      (*env)->DeleteLocalRef(env, member);
+
+      if (!pyjmethod ||
+          JcpPyJMultiMethod_Append((PyJMultiMethodObject *)attr, pyjmethod) <
+              0) {
+        Py_XDECREF(pyjmethod);
+        Py_CLEAR(attr);
+        break;
       }
-      Py_DECREF(pyjfield);
+      Py_DECREF(pyjmethod);
     }
-    (*env)->DeleteLocalRef(env, fields);
+  }
 
-    PyDict_SetItem(jcpThread->name_to_attrs, self->class_name, cachedAttrs);
-    Py_DECREF(cachedAttrs);
+CACHE:
+  if (attr) {
+    if (PyDict_SetItem(attrs, name, attr) < 0) {
+      Py_CLEAR(attr);
+    } else {
+      // the attributes of the class hold the reference
+      Py_DECREF(attr);
+    }
   }
 
-  if (self->object) {
-    Py_INCREF(cachedAttrs);
-    self->attr = cachedAttrs;
+EXIT:
+  (*env)->PopLocalFrame(env, NULL);
+  return attr;
+}
+
+/* Installs the public methods or field of the given name of the Java class of
+ * an object into its Python type, on the first access of the name. Returns 0
+ * if the class has no such member, 1 if it has been installed and -1 with an
+ * exception set on failure. */
+
+static int pyjobject_install_attr(PyJObject *self, PyObject *name) {
+  JNIEnv *env;
+  PyObject *attrs, *attr;
+  int ret;
+
+  env = JcpThreadEnv_Get();
+
+  // the resolved members are cached by class identity across the threads
+  attrs = JcpClassAttrs_Get(env, self->clazz, self->class_name);
+  if (!attrs) {
+    return -1;
+  }
+
+  attr = PyDict_GetItem(attrs, name);
+  if (!attr) {
+    attr = pyjobject_resolve_attr(self->clazz, attrs, name);
+  }
+
+  if (!attr) {
+    ret = -1;
+  } else if (attr == Py_None) {
+    ret = 0;
   } else {
-    self->attr = PyDict_Copy(cachedAttrs);
+    // setting an attribute of a type calls PyType_Modified, which invalidates
+    // the attribute cache of the type
+    ret = PyObject_SetAttr((PyObject *)Py_TYPE(self), name, attr) < 0 ? -1 : 1;
   }
 
-  (*env)->PopLocalFrame(env, NULL);
-  return 0;
+  Py_DECREF(attrs);
+  return ret;
+}
 
-EXIT_ERROR:
-  (*env)->PopLocalFrame(env, NULL);
-  return -1;
+/* Gets the Java method or field of the given name of a PyJObject. Returns a
+ * borrowed reference, or Py_None if there is no such member. */
+
+PyObject *JcpPyJObject_GetMember(PyJObject *self, PyObject *name) {
+  PyObject *attr;
+
+  if (!self->attr) {
+    // the members of an object of a Java class type live in its type
+    attr = _PyType_Lookup(Py_TYPE(self), name);
+    if (!attr) {
+      if (pyjobject_install_attr(self, name) < 0) {
+        return NULL;
+      }
+      attr = _PyType_Lookup(Py_TYPE(self), name);
+    }
+    return attr ? attr : Py_None;
+  }
+
+  attr = PyDict_GetItem(self->attr, name);
+  return attr ? attr : pyjobject_resolve_attr(self->clazz, self->attr, name);
 }
 
 static void pyjobject_dealloc(PyJObject *self) {
+  PyTypeObject *type = Py_TYPE(self);
   JNIEnv *env;
 
   env = JcpThreadEnv_Get();
@@ -158,9 +203,11 @@ static void pyjobject_dealloc(PyJObject *self) {
   }
 
   Py_CLEAR(self->attr);
-  Py_DECREF(self->class_name);
+  Py_CLEAR(self->class_name);
 
-  PyObject_Del(self);
+  type->tp_free((PyObject *)self);
+  // the instances of heap types hold a reference to their type
+  Py_DECREF(type);
 }
 
 static PyObject *pyjobject_str(PyJObject *self) {
@@ -184,8 +231,16 @@ static PyObject *pyjobject_getattro(PyObject *self, PyObject *name) {
   cachedAttrs = ((PyJObject *)self)->attr;
   attr = PyDict_GetItem(cachedAttrs, name);
 
-  result = NULL;
   if (attr == NULL) {
+    attr = pyjobject_resolve_attr(((PyJObject *)self)->clazz, cachedAttrs,
+                                  name);
+    if (attr == NULL) {
+      return NULL;
+    }
+  }
+
+  result = NULL;
+  if (attr == Py_None) {
     return PyObject_GenericGetAttr(self, name);
   } else if (PyJMethod_Check(attr) || PyJMultiMethod_Check(attr)) {
     result = PyMethod_New(attr, self);
@@ -203,6 +258,13 @@ static int pyjobject_setattro(PyJObject *self, PyObject *name,
   attr = PyDict_GetItem(cachedAttrs, name);
 
   if (attr == NULL) {
+    attr = pyjobject_resolve_attr(self->clazz, cachedAttrs, name);
+    if (attr == NULL) {
+      return -1;
+    }
+  }
+
+  if (attr == Py_None) {
     return PyObject_GenericSetAttr(self->attr, name, value);
   }
 
@@ -214,11 +276,217 @@ static int pyjobject_setattro(PyJObject *self, PyObject *name,
   return JcpPyJField_Set((PyJFieldObject *)attr, self, value);
 }
 
+/* The __getattr__ of a Java class type, which the generic lookup only calls on
+ * a miss. The public methods and fields of the class are installed into its
+ * type on the first miss, so that creating the type doesn't reflect all of
+ * them, while the hits stay on the generic path. */
+
+static PyObject *pyjobject_class_getattr(PyObject *unused, PyObject *args) {
+  PyObject *self, *name;
+  int installed;
+
+  if (!PyArg_ParseTuple(args, "O!U", &PyJObject_Type, &self, &name)) {
+    return NULL;
+  }
+
+  installed = pyjobject_install_attr((PyJObject *)self, name);
+  if (installed < 0) {
+    return NULL;
+  } else if (installed == 0) {
+    PyErr_Format(PyExc_AttributeError, "'%s' object has no attribute '%U'",
+                 Py_TYPE(self)->tp_name, name);
+    return NULL;
+  }
+
+  return PyObject_GenericGetAttr(self, name);
+}
+
+static PyMethodDef pyjobject_class_getattr_def = {
+    "__getattr__", (PyCFunction)pyjobject_class_getattr, METH_VARARGS, ""};
+
+/* Adds the lookup of the attributes of a Java class type to its members.
+ * object.__getattribute__ replaces the one of PyJObject, so that the hits are
+ * looked up generically. */
+
+static int pyjobject_class_lookup(PyObject *members) {
+  PyObject *getattribute, *func, *getattr = NULL;
+  int ret = -1;
+
+  getattribute = PyObject_GetAttrString((PyObject *)&PyBaseObject_Type,
+                                        "__getattribute__");
+  func = PyCFunction_New(&pyjobject_class_getattr_def, NULL);
+  if (getattribute && func) {
+    // binds the objects like the methods defined in Python
+    getattr = PyInstanceMethod_New(func);
+  }
+
+  if (getattr &&
+      PyDict_SetItemString(members, "__getattribute__", getattribute) == 0 &&
+      PyDict_SetItemString(members, "__getattr__", getattr) == 0) {
+    ret = 0;
+  }
+
+  Py_XDECREF(getattribute);
+  Py_XDECREF(func);
+  Py_XDECREF(getattr);
+  return ret;
+}
+
+static int pyjobject_class_setattro(PyObject *self, PyObject *name,
+                                    PyObject *value) {
+  if (!_PyType_Lookup(Py_TYPE(self), name) &&
+      pyjobject_install_attr((PyJObject *)self, name) < 0) {
+    return -1;
+  }
+
+  return PyObject_GenericSetAttr(self, name, value);
+}
+
+/* Creates the Python type of a Java class. Its public methods and fields are
+ * installed into the type as descriptors once accessed, so that the attribute
+ * cache of Python types and the specialized attribute access of the
+ * interpreter apply to the Java objects. */
+
+static PyTypeObject *pyjobject_new_class_type(PyObject *class_name) {
+  PyObject *members, *name = NULL, *module = NULL, *slots = NULL;
+  PyTypeObject *type = NULL;
+  Py_ssize_t len, dot;
+
+  members = PyDict_New();
+  if (!members) {
+    return NULL;
+  }
+
+  len = PyUnicode_GET_LENGTH(class_name);
+  dot = PyUnicode_FindChar(class_name, '.', 0, len, -1);
+  if (dot == -2) {
+    goto EXIT;
+  }
+
+  // e.g. `java.util.ArrayList` is named `ArrayList` in module `java.util`
+  name = PyUnicode_Substring(class_name, dot + 1, len);
+  module = PyUnicode_Substring(class_name, 0, dot < 0 ? 0 : dot);
+  slots = PyTuple_New(0);
+  if (!name || !module || !slots) {
+    goto EXIT;
+  }
+
+  if (PyDict_SetItemString(members, "__module__", module) < 0 ||
+      PyDict_SetItemString(members, "__slots__", slots) < 0 ||
+      pyjobject_class_lookup(members) < 0) {
+    goto EXIT;
+  }
+
+  type = (PyTypeObject *)PyObject_CallFunction(
+      (PyObject *)&PyType_Type, "O(O)O", name, &PyJObject_Type, members);
+
+  if (type) {
+    // the members are only set in the type
+    type->tp_setattro = pyjobject_class_setattro;
+    PyType_Modified(type);
+  }
+
+EXIT:
+  Py_DECREF(members);
+  Py_XDECREF(name);
+  Py_XDECREF(module);
+  Py_XDECREF(slots);
+  return type;
+}
+
+/* Gets the cached Python type of a Java class or creates it. Returns a new
+ * reference, or NULL without an exception set if the type can't be cached in
+ * the current thread. */
+
+static PyTypeObject *pyjobject_class_type(JNIEnv *env, jclass clazz,
+                                          PyObject *class_name) {
+  PyTypeObject *type, *cached;
+
+  type = JcpClassType_Get(env, clazz, class_name);
+  if (type || PyErr_Occurred()) {
+    return type;
+  }
+
+  if (!JcpClassType_Enabled()) {
+    return NULL;
+  }
+
+  type = pyjobject_new_class_type(class_name);
+  if (!type) {
+    return NULL;
+  }
+
+  // the type cached by another thread meanwhile may be returned instead
+  cached = JcpClassType_Put(env, clazz, class_name, type);
+  Py_DECREF(type);
+  return cached;
+}
+
+/* Creates a new instance of the Python type of the Java class of the object.
+ * Returns NULL without an exception set if the type isn't available. */
+
+static PyObject *pyjobject_new_instance(JNIEnv *env, jobject object,
+                                        jclass clazz) {
+  jclass objectClass;
+  jstring className;
+
+  PyObject *class_name = NULL;
+  PyTypeObject *type;
+  PyJObject *self = NULL;
+
+  objectClass = clazz ? clazz : (*env)->GetObjectClass(env, object);
+
+  className = JavaClass_getName(env, objectClass);
+  if (!className) {
+    JcpJavaErr_Throw(env);
+    goto EXIT;
+  }
+
+  class_name = JcpPyString_FromJString(env, className);
+  (*env)->DeleteLocalRef(env, className);
+  if (!class_name) {
+    goto EXIT;
+  }
+
+  type = pyjobject_class_type(env, objectClass, class_name);
+  if (!type) {
+    goto EXIT;
+  }
+
+  self = (PyJObject *)type->tp_alloc(type, 0);
+  Py_DECREF(type);
+  if (!self) {
+    goto EXIT;
+  }
+
+  self->object = (*env)->NewGlobalRef(env, object);
+  self->clazz = (*env)->NewGlobalRef(env, objectClass);
+  self->attr = NULL;
+  self->class_name = class_name;
+  class_name = NULL;
+
+EXIT:
+  Py_XDECREF(class_name);
+  if (!clazz) {
+    (*env)->DeleteLocalRef(env, objectClass);
+  }
+  return (PyObject *)self;
+}
+
 PyObject *JcpPyJObject_New(JNIEnv *env, PyTypeObject *type, jobject object,
                            jclass clazz) {
   PyJObject *self;
 
+  if (type == &PyJObject_Type && object) {
+    self = (PyJObject *)pyjobject_new_instance(env, object, clazz);
+    if (self || PyErr_Occurred()) {
+      return (PyObject *)self;
+    }
+  }
+
   self = PyObject_NEW(PyJObject, type);
+  self->attr = NULL;
+  self->class_name = NULL;
 
   if (object) {
     self->object = (*env)->NewGlobalRef(env, object);
@@ -245,42 +513,19 @@ PyObject *JcpPyJObject_New(JNIEnv *env, PyTypeObject *type, jobject object,
   return (PyObject *)self;
 }
 
-PyTypeObject PyJObject_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0) "pemja.PyJObject", /* tp_name */
-    sizeof(PyJObject),                                /* tp_basicsize */
-    0,                                                /* tp_itemsize */
-    (destructor)pyjobject_dealloc,                    /* tp_dealloc */
-    0,                                                /* tp_print */
-    0,                                                /* tp_getattr */
-    0,                                                /* tp_setattr */
-    0,                                                /* tp_reserved */
-    0,                                                /* tp_repr */
-    0,                                                /* tp_as_number */
-    0,                                                /* tp_as_sequence */
-    0,                                                /* tp_as_mapping */
-    0,                                                /* tp_hash */
-    0,                                                /* tp_call */
-    (reprfunc)pyjobject_str,                          /* tp_str */
-    (getattrofunc)pyjobject_getattro,                 /* tp_getattro */
-    (setattrofunc)pyjobject_setattro,                 /* tp_setattro */
-    0,                                                /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,         /* tp_flags */
-    "Java Object",                                    /* tp_doc */
-    0,                                                /* tp_traverse */
-    0,                                                /* tp_clear */
-    0,                                                /* tp_richcompare */
-    0,                                                /* tp_weaklistoffset */
-    0,                                                /* tp_iter */
-    0,                                                /* tp_iternext */
-    0,                                                /* tp_methods */
-    0,                                                /* tp_members */
-    0,                                                /* tp_getset */
-    0,                                                /* tp_base */
-    0,                                                /* tp_dict */
-    0,                                                /* tp_descr_get */
-    0,                                                /* tp_descr_set */
-    0,                                                /* tp_dictoffset */
-    0,                                                /* tp_init */
-    0,                                                /* tp_alloc */
-    0,                                                /* tp_new */
+static PyType_Slot pyjobject_slots[] = {
+    {Py_tp_doc, "Java Object"},
+    {Py_tp_dealloc, (void *)pyjobject_dealloc},
+    {Py_tp_str, (void *)pyjobject_str},
+    {Py_tp_getattro, (void *)pyjobject_getattro},
+    {Py_tp_setattro, (void *)pyjobject_setattro},
+    {0, NULL},
+};
+
+PyType_Spec PyJObject_Spec = {
+    "pemja.PyJObject",                        /* name */
+    sizeof(PyJObject),                        /* basicsize */
+    0,                                        /* itemsize */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /* flags */
+    pyjobject_slots,                          /* slots */
 };
@@ -177,10 +177,15 @@ int JcpJObject_GetObjectId(JNIEnv* env, jclass clazz) {
 /* Function to returns the match degree of the PyObject and the jclass */
 
 int JcpPyObject_match(JNIEnv* env, PyObject* pyobject, jclass clazz) {
-  int object_id;
+  return JcpPyObject_matchWithId(env, pyobject, clazz,
+                                 JcpJObject_GetObjectId(env, clazz));
+}
 
-  object_id = JcpJObject_GetObjectId(env, clazz);
+/* Function to returns the match degree of the PyObject and the jclass with the
+ * precomputed object id of the jclass */
 
+int JcpPyObject_matchWithId(JNIEnv* env, PyObject* pyobject, jclass clazz,
+                            int object_id) {
   if (PyBool_Check(pyobject)) {
     switch (object_id) {
       case JBOOLEAN_ID:
@@ -278,6 +283,23 @@ int JcpPyObject_match(JNIEnv* env, PyObject* pyobject, jclass clazz) {
   return 0;
 }
 
+/* Function to check whether Java collections are copied eagerly into Python
+ * lists and dicts instead of being proxied lazily */
+
+static int JcpPyObject_IsEagerCopy(void) {
+  JcpThread* jcp_thread;
+
+  jcp_thread = JcpThread_Get();
+
+  if (jcp_thread == NULL) {
+    // Threads started in Python have no JcpThread, keep the lazy proxies.
+    PyErr_Clear();
+    return 0;
+  }
+
+  return jcp_thread->conversion_policy == JCP_EAGER_COPY;
+}
+
 /* Function to return a Python Object from a Java Object */
 
 PyObject* JcpPyObject_FromJObject(JNIEnv* env, jobject value) {
@@ -360,9 +382,17 @@ PyObject* JcpPyObject_FromJObject(JNIEnv* env, jobject value) {
       free(msg);
     }
   } else if ((*env)->IsAssignableFrom(env, clazz, JLIST_TYPE)) {
-    result = JcpPyJList_New(env, value, clazz);
+    if (JcpPyObject_IsEagerCopy()) {
+      result = JcpPyList_FromJListObject(env, value);
+    } else {
+      result = JcpPyJList_New(env, value, clazz);
+    }
   } else if ((*env)->IsAssignableFrom(env, clazz, JMAP_TYPE)) {
-    result = JcpPyJDict_New(env, value, clazz);
+    if (JcpPyObject_IsEagerCopy()) {
+      result = JcpPyDict_FromJMap(env, value);
+    } else {
+      result = JcpPyJDict_New(env, value, clazz);
+    }
   } else if ((*env)->IsSameObject(env, clazz, JCHAR_OBJ_TYPE)) {
     result = JcpPyString_FromJChar(env, value);
   } else if ((*env)->IsAssignableFrom(env, clazz, JUTILDATE_TYPE)) {
@@ -385,7 +415,11 @@ PyObject* JcpPyObject_FromJObject(JNIEnv* env, jobject value) {
       free(msg);
     }
   } else if ((*env)->IsAssignableFrom(env, clazz, JCOLLECTION_TYPE)) {
-    result = JcpPyJCollection_New(env, value, clazz);
+    if (JcpPyObject_IsEagerCopy()) {
+      result = JcpPyList_FromJListObject(env, value);
+    } else {
+      result = JcpPyJCollection_New(env, value, clazz);
+    }
   } else if ((*env)->IsAssignableFrom(env, clazz, JITERABLE_TYPE)) {
     result = JcpPyJIterable_New(env, value, clazz);
   } else if ((*env)->IsAssignableFrom(env, clazz, JITERATOR_TYPE)) {
@@ -1059,6 +1093,12 @@ jobject JcpPyObject_AsJObject(JNIEnv* env, PyObject* pyobject, jclass clazz) {
     return (*env)->NewLocalRef(env, ((PyJObject*)pyobject)->object);
   } else if (PyGen_CheckExact(pyobject)) {
     return JcpPyGenerator_AsJObject(env, pyobject);
+  } else if (PyList_Check(pyobject) &&
+             (*env)->IsSameObject(env, clazz, JPYLIST_TYPE)) {
+    return JcpPyList_AsJPyList(env, pyobject);
+  } else if (PyDict_Check(pyobject) &&
+             (*env)->IsSameObject(env, clazz, JPYDICT_TYPE)) {
+    return JcpPyDict_AsJPyDict(env, pyobject);
   } else if (PyBool_Check(pyobject)) {
     return JcpPyBool_AsJObject(env, pyobject, clazz);
   } else if (PyLong_CheckExact(pyobject)) {
@@ -1093,71 +1133,158 @@ jobject JcpPyObject_AsJObject(JNIEnv* env, PyObject* pyobject, jclass clazz) {
   }
 }
 
-/* Function to return a jvalue from a Python Object */
+/* Functions to return a jvalue of a specific Java Class from a Python Object */
 
-JcpAPI_FUNC(jvalue)
-    JcpPyObject_AsJValue(JNIEnv* env, PyObject* pyobject, jclass clazz) {
-  int object_id;
+static jvalue JcpPyObject_AsJValueString(JNIEnv* env, PyObject* pyobject,
+                                         jclass clazz) {
   jvalue result;
+  result.l = JcpPyString_AsJString(env, pyobject);
+  return result;
+}
 
-  object_id = JcpJObject_GetObjectId(env, clazz);
-
-  if (pyobject == Py_None) {
-    result.l = NULL;
-    return result;
+static jvalue JcpPyObject_AsJValueObject(JNIEnv* env, PyObject* pyobject,
+                                         jclass clazz) {
+  jvalue result;
+  if (PyJObject_Check(pyobject)) {
+    result.l = (*env)->NewLocalRef(env, ((PyJObject*)pyobject)->object);
+  } else {
+    result.l = JcpPyObject_AsJObject(env, pyobject, clazz);
   }
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueBytes(JNIEnv* env, PyObject* pyobject,
+                                        jclass clazz) {
+  jvalue result;
+  result.l = JcpPyBytes_AsJObject(env, pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueList(JNIEnv* env, PyObject* pyobject,
+                                       jclass clazz) {
+  jvalue result;
+  result.l = JcpPyList_AsJObject(env, pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueMap(JNIEnv* env, PyObject* pyobject,
+                                      jclass clazz) {
+  jvalue result;
+  result.l = JcpPyDict_AsJObject(env, pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueArray(JNIEnv* env, PyObject* pyobject,
+                                        jclass clazz) {
+  jvalue result;
+  result.l = JcpPyTuple_AsJObject(env, pyobject, clazz);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueInt(JNIEnv* env, PyObject* pyobject,
+                                      jclass clazz) {
+  jvalue result;
+  result.i = JcpPyInt_AsJInt(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueDouble(JNIEnv* env, PyObject* pyobject,
+                                         jclass clazz) {
+  jvalue result;
+  result.d = JcpPyFloat_AsJDouble(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueFloat(JNIEnv* env, PyObject* pyobject,
+                                        jclass clazz) {
+  jvalue result;
+  result.f = JcpPyFloat_AsJFloat(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueLong(JNIEnv* env, PyObject* pyobject,
+                                       jclass clazz) {
+  jvalue result;
+  result.j = JcpPyInt_AsJLong(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueBoolean(JNIEnv* env, PyObject* pyobject,
+                                          jclass clazz) {
+  jvalue result;
+  result.z = JcpPyBool_AsJBoolean(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueByte(JNIEnv* env, PyObject* pyobject,
+                                       jclass clazz) {
+  jvalue result;
+  result.b = JcpPyInt_AsJByte(pyobject);
+  return result;
+}
 
+static jvalue JcpPyObject_AsJValueShort(JNIEnv* env, PyObject* pyobject,
+                                        jclass clazz) {
+  jvalue result;
+  result.s = JcpPyInt_AsJShort(pyobject);
+  return result;
+}
+
+static jvalue JcpPyObject_AsJValueUnknown(JNIEnv* env, PyObject* pyobject,
+                                          jclass clazz) {
+  jvalue result;
+  PyErr_Format(PyExc_TypeError, "Unrecognized class %s.",
+               JcpString_FromJString(env, JavaClass_getName(env, clazz)));
+  result.l = NULL;
+  return result;
+}
+
+/* Function to return the converter of Python Objects to jvalues of the Java
+ * Class with the object id */
+
+JcpPyObject_JValueConverter JcpPyObject_GetJValueConverter(int object_id) {
   switch (object_id) {
     case JSTRING_ID:
-      result.l = JcpPyString_AsJString(env, pyobject);
-      break;
+      return JcpPyObject_AsJValueString;
     case JOBJECT_ID:
-      if (PyJObject_Check(pyobject)) {
-        result.l = (*env)->NewLocalRef(env, ((PyJObject*)pyobject)->object);
-      } else {
-        result.l = JcpPyObject_AsJObject(env, pyobject, clazz);
-      }
-      break;
+      return JcpPyObject_AsJValueObject;
     case JBYTES_ID:
-      result.l = JcpPyBytes_AsJObject(env, pyobject);
-      break;
+      return JcpPyObject_AsJValueBytes;
     case JLIST_ID:
-      result.l = JcpPyList_AsJObject(env, pyobject);
-      break;
+      return JcpPyObject_AsJValueList;
     case JMAP_ID:
-      result.l = JcpPyDict_AsJObject(env, pyobject);
-      break;
+      return JcpPyObject_AsJValueMap;
     case JINT_ID:
-      result.i = JcpPyInt_AsJInt(pyobject);
-      break;
+      return JcpPyObject_AsJValueInt;
     case JDOUBLE_ID:
-      result.d = JcpPyFloat_AsJDouble(pyobject);
-      break;
+      return JcpPyObject_AsJValueDouble;
     case JFLOAT_ID:
-      result.f = JcpPyFloat_AsJFloat(pyobject);
-      break;
+      return JcpPyObject_AsJValueFloat;
     case JLONG_ID:
-      result.j = JcpPyInt_AsJLong(pyobject);
-      break;
+      return JcpPyObject_AsJValueLong;
     case JBOOLEAN_ID:
-      result.z = JcpPyBool_AsJBoolean(pyobject);
-      break;
+      return JcpPyObject_AsJValueBoolean;
     case JBYTE_ID:
-      result.b = JcpPyInt_AsJByte(pyobject);
-      break;
+      return JcpPyObject_AsJValueByte;
     case JSHORT_ID:
-      result.s = JcpPyInt_AsJShort(pyobject);
-      break;
+      return JcpPyObject_AsJValueShort;
     case JARRAY_ID:
-      result.l = JcpPyTuple_AsJObject(env, pyobject, clazz);
-      break;
+      return JcpPyObject_AsJValueArray;
     default:
-      PyErr_Format(PyExc_TypeError, "Unrecognized class %s.",
-                   JcpString_FromJString(env, JavaClass_getName(env, clazz)));
-      result.l = NULL;
+      return JcpPyObject_AsJValueUnknown;
   }
+}
 
-  return result;
+/* Function to return a jvalue from a Python Object */
+
+JcpAPI_FUNC(jvalue)
+    JcpPyObject_AsJValue(JNIEnv* env, PyObject* pyobject, jclass clazz) {
+  JcpPyObject_JValueConverter converter;
+
+  converter =
+      JcpPyObject_GetJValueConverter(JcpJObject_GetObjectId(env, clazz));
+
+  return _JcpPyObject_AsJValue(env, pyobject, clazz, converter);
 }
 
 /* ----- Functions to return a Java primitive value from a Python primitive
@@ -1849,6 +1976,20 @@ jobject JcpPyGenerator_AsJObject(JNIEnv* env, PyObject* pyobject) {
   return jiter;
 }
 
+/* Function to return a Java PyList view over a Python List */
+
+jobject JcpPyList_AsJPyList(JNIEnv* env, PyObject* pyobject) {
+  Py_INCREF(pyobject);
+  return JavaPyList_New(env, (intptr_t)JcpThread_Get(), (intptr_t)pyobject);
+}
+
+/* Function to return a Java PyDict view over a Python Dict */
+
+jobject JcpPyDict_AsJPyDict(JNIEnv* env, PyObject* pyobject) {
+  Py_INCREF(pyobject);
+  return JavaPyDict_New(env, (intptr_t)JcpThread_Get(), (intptr_t)pyobject);
+}
+
 /* Function to return a Java PyObject from a Python object */
 
 jobject JcpPyObject_AsJPyObject(JNIEnv* env, PyObject* pyobject) {
@@ -0,0 +1,168 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// the extensions are built with -std=c99, which hides syscall and nanosleep
+#define _GNU_SOURCE
+
+#include <Futex.h>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <windows.h>
+#else
+#include <time.h>
+#if defined(__linux__)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+/* The times a position is polled before its waiter goes to sleep, as the
+ * other process mostly answers within a few microseconds. */
+#define PEMJA_FUTEX_SPINS 1024
+
+/* The offset of the flag of the waiter of a position */
+#define PEMJA_FUTEX_WAITER 8
+
+#if (defined(_WIN32) || defined(_WIN64))
+#define pemja_load64(p) InterlockedCompareExchange64((LONG64 *)(p), 0, 0)
+#define pemja_store64(p, v) InterlockedExchange64((LONG64 *)(p), (v))
+#define pemja_load32(p) InterlockedCompareExchange((LONG *)(p), 0, 0)
+#define pemja_store32(p, v) InterlockedExchange((LONG *)(p), (v))
+#else
+#define pemja_load64(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define pemja_store64(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define pemja_load32(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define pemja_store32(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
+static int32_t *pemja_futex_waiter(int64_t *position) {
+  return (int32_t *)((char *)position + PEMJA_FUTEX_WAITER);
+}
+
+#if defined(__linux__)
+
+/* The futex is the low half of the position, as it is 4 bytes. The positions
+ * never advance by 2^32 while a waiter sleeps, since a ring buffer holds one
+ * message at most. */
+
+static uint32_t *pemja_futex_word(int64_t *position) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  return (uint32_t *)position + 1;
+#else
+  return (uint32_t *)position;
+#endif
+}
+
+static void pemja_futex_sleep(int64_t *position, int64_t expected,
+                              int64_t timeout_nanos) {
+  struct timespec timeout;
+
+  timeout.tv_sec = timeout_nanos / 1000000000;
+  timeout.tv_nsec = timeout_nanos % 1000000000;
+  // the futex is shared with another process, so it can't be private
+  syscall(SYS_futex, pemja_futex_word(position), FUTEX_WAIT,
+          (uint32_t)expected, &timeout, NULL, 0);
+}
+
+static void pemja_futex_wake(int64_t *position) {
+  syscall(SYS_futex, pemja_futex_word(position), FUTEX_WAKE, INT_MAX, NULL,
+          NULL, 0);
+}
+
+#else
+
+/* The other systems have no futex working across processes, so the waiter
+ * polls the position with short sleeps. */
+
+static void pemja_futex_sleep(int64_t *position, int64_t expected,
+                              int64_t timeout_nanos) {
+#if (defined(_WIN32) || defined(_WIN64))
+  Sleep(1);
+#else
+  struct timespec timeout = {0, 50000};
+  nanosleep(&timeout, NULL);
+#endif
+}
+
+static void pemja_futex_wake(int64_t *position) {}
+
+#endif
+
+/* Load a position written by the other process */
+
+int64_t pemja_futex_load(int64_t *position) { return pemja_load64(position); }
+
+/* Store a position and wake up its waiter if it sleeps. The flag of the waiter
+ * is read after the position is stored, and the waiter sets it before reading
+ * the position again, so that either the waiter sees the position or the
+ * waiter is woken up. */
+
+void pemja_futex_store(int64_t *position, int64_t value) {
+  pemja_store64(position, value);
+  if (pemja_load32(pemja_futex_waiter(position))) {
+    pemja_futex_wake(position);
+  }
+}
+
+/* Wait until a position differs from the expected one, or the timeout expires.
+ * Returns the current position. */
+
+int64_t pemja_futex_wait(int64_t *position, int64_t expected,
+                         int64_t timeout_nanos) {
+  int64_t value;
+
+  for (int i = 0; i < PEMJA_FUTEX_SPINS; i++) {
+    value = pemja_load64(position);
+    if (value != expected) {
+      return value;
+    }
+  }
+
+  pemja_store32(pemja_futex_waiter(position), 1);
+  if (pemja_load64(position) == expected) {
+    pemja_futex_sleep(position, expected, timeout_nanos);
+  }
+  pemja_store32(pemja_futex_waiter(position), 0);
+
+  return pemja_load64(position);
+}
+
+static int64_t *pemja_futex_position(JNIEnv *env, jobject buffer,
+                                     jint offset) {
+  return (int64_t *)((char *)(*env)->GetDirectBufferAddress(env, buffer) +
+                     offset);
+}
+
+JNIEXPORT jlong JNICALL Java_pemja_utils_Futex_load(JNIEnv *env, jclass cls,
+                                                    jobject buffer,
+                                                    jint offset) {
+  return pemja_futex_load(pemja_futex_position(env, buffer, offset));
+}
+
+JNIEXPORT void JNICALL Java_pemja_utils_Futex_store(JNIEnv *env, jclass cls,
+                                                    jobject buffer, jint offset,
+                                                    jlong value) {
+  pemja_futex_store(pemja_futex_position(env, buffer, offset), value);
+}
+
+JNIEXPORT jlong JNICALL Java_pemja_utils_Futex_await(JNIEnv *env, jclass cls,
+                                                     jobject buffer,
+                                                     jint offset,
+                                                     jlong expected,
+                                                     jlong timeout) {
+  return pemja_futex_wait(pemja_futex_position(env, buffer, offset), expected,
+                          timeout);
+}
@@ -0,0 +1,63 @@
+// Copyright 2022 Alibaba Group Holding Limited.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <jni.h>
+#include <stdint.h>
+/* Header for class pemja_utils_Futex */
+
+#ifndef _Included_pemja_utils_Futex
+#define _Included_pemja_utils_Futex
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The positions of the ring buffers shared with the Python worker processes.
+ * Every position is 8 bytes, followed by the 4 bytes flag of its waiter. The
+ * functions are exported for the Python worker processes as well, which call
+ * them through ctypes.
+ */
+JNIEXPORT int64_t pemja_futex_load(int64_t *position);
+JNIEXPORT void pemja_futex_store(int64_t *position, int64_t value);
+JNIEXPORT int64_t pemja_futex_wait(int64_t *position, int64_t expected,
+                                   int64_t timeout_nanos);
+
+/*
+ * Class:     pemja_utils_Futex
+ * Method:    load
+ * Signature: (Ljava/nio/ByteBuffer;I)J
+ */
+JNIEXPORT jlong JNICALL Java_pemja_utils_Futex_load(JNIEnv *, jclass, jobject,
+                                                    jint);
+
+/*
+ * Class:     pemja_utils_Futex
+ * Method:    store
+ * Signature: (Ljava/nio/ByteBuffer;IJ)V
+ */
+JNIEXPORT void JNICALL Java_pemja_utils_Futex_store(JNIEnv *, jclass, jobject,
+                                                    jint, jlong);
+
+/*
+ * Class:     pemja_utils_Futex
+ * Method:    await
+ * Signature: (Ljava/nio/ByteBuffer;IJJ)J
+ */
+JNIEXPORT jlong JNICALL Java_pemja_utils_Futex_await(JNIEnv *, jclass, jobject,
+                                                     jint, jlong, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,703 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core;
+
+import pemja.utils.CommonUtils;
+import pemja.utils.Futex;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.RandomAccessFile;
+import java.lang.reflect.Array;
+import java.math.BigDecimal;
+import java.math.BigInteger;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.ReentrantLock;
+
+/**
+ * An {@link Interpreter} running Python code in local worker processes, which is created with the
+ * {@link PythonInterpreterConfig.ExecType#PROCESS} exec type.
+ *
+ * <p>Each worker process runs its own CPython, so the workers run Python code in parallel without
+ * sharing a GIL, and the Python libraries not supporting sub interpreters can be used. The calls
+ * are exchanged with a worker through a pair of ring buffers in a shared memory file, whose
+ * positions are waited for with futexes on Linux, and the Java objects are copied into it in a
+ * compact binary encoding. Only {@code null}, booleans, numbers, {@link BigInteger}, {@link
+ * BigDecimal}, strings, {@code byte[]}, arrays, {@link Collection}s and {@link Map}s of them can
+ * be passed to and returned from the workers, and Python code can't call Java.
+ *
+ * <p>The interpreter can be used by any threads. {@link #invoke} and {@link #get} run on an idle
+ * worker, while {@link #set} and {@link #exec} run on every worker one after another, so that
+ * the workers share the same functions. If they fail in some of the workers only, the workers
+ * differ from each other, so the interpreter is closed. The workers exiting unexpectedly are
+ * skipped by the later calls, e.g.:
+ *
+ * <pre>{@code
+ * PythonInterpreterConfig config =
+ *         PythonInterpreterConfig.newBuilder()
+ *                 .setExcType(PythonInterpreterConfig.ExecType.PROCESS)
+ *                 .build();
+ * try (ProcessPythonInterpreter interpreter = new ProcessPythonInterpreter(config, 8)) {
+ *     interpreter.exec("from udfs import normalize");
+ *     Object result = interpreter.invoke("normalize", "Pemja");
+ * }
+ * }</pre>
+ *
+ * <p>The functions invoked should therefore be stateless, since the global variables they change
+ * are only changed in the worker running them.
+ */
+public final class ProcessPythonInterpreter implements Interpreter {
+
+    private static final long serialVersionUID = 1L;
+
+    /** The capacity of the data of a ring buffer, which limits the size of a message. */
+    private static final int RING_CAPACITY = 1 << 22;
+
+    /** The offset of the position written by the producer of a ring buffer. */
+    private static final int TAIL_OFFSET = 0;
+
+    /** The offset of the position written by the consumer, in another cache line. */
+    private static final int HEAD_OFFSET = 64;
+
+    private static final int DATA_OFFSET = 128;
+
+    private static final int RING_SIZE = DATA_OFFSET + RING_CAPACITY;
+
+    /** The time waiting for a response before checking whether the worker is still alive. */
+    private static final long WAIT_NANOS = TimeUnit.MILLISECONDS.toNanos(100);
+
+    private static final String WORKER_SCRIPT = "process_worker.py";
+
+    /** The tags of the encoded values, which must be kept in sync with process_worker.py. */
+    private static final byte NONE = 0;
+    private static final byte FALSE = 1;
+    private static final byte TRUE = 2;
+    private static final byte INT = 3;
+    private static final byte BIG_INT = 4;
+    private static final byte FLOAT = 5;
+    private static final byte STR = 6;
+    private static final byte BYTES = 7;
+    private static final byte LIST = 8;
+    private static final byte TUPLE = 9;
+    private static final byte DICT = 10;
+    private static final byte DECIMAL = 11;
+
+    /** The operations of the requests. */
+    private static final int SET = 0;
+    private static final int GET = 1;
+    private static final int INVOKE = 2;
+    private static final int INVOKE_METHOD = 3;
+    private static final int EXEC = 4;
+
+    private final Worker[] workers;
+
+    private final AtomicInteger next = new AtomicInteger();
+
+    private volatile boolean closed;
+
+    /**
+     * Creates the interpreter and starts its worker processes.
+     *
+     * @param config the config of the interpreter, whose exec type must be {@link
+     *     PythonInterpreterConfig.ExecType#PROCESS}
+     * @param processes the number of the worker processes
+     */
+    public ProcessPythonInterpreter(PythonInterpreterConfig config, int processes) {
+        if (config.getExecType() != PythonInterpreterConfig.ExecType.PROCESS) {
+            throw new IllegalArgumentException(
+                    "The exec type of the config must be PROCESS, but it is "
+                            + config.getExecType()
+                            + ".");
+        }
+        if (processes <= 0) {
+            throw new IllegalArgumentException("The number of processes must be positive.");
+        }
+
+        CommonUtils.INSTANCE.loadUtils(config.getPythonExec());
+        workers = new Worker[processes];
+        try {
+            for (int i = 0; i < processes; i++) {
+                workers[i] = new Worker(config);
+            }
+        } catch (IOException e) {
+            close();
+            throw new RuntimeException("Failed to start the Python worker processes.", e);
+        }
+    }
+
+    @Override
+    public void set(String name, Object value) {
+        broadcast(request(SET, name, value));
+    }
+
+    @Override
+    public Object get(String name) {
+        return call(request(GET, name));
+    }
+
+    @Override
+    public <T> T get(String name, Class<T> clazz) {
+        return convert(get(name), clazz);
+    }
+
+    @Override
+    public Object invoke(String name, Object... args) {
+        return call(request(INVOKE, name, args, null));
+    }
+
+    @Override
+    public Object invoke(String name, Map<String, Object> kwargs) {
+        return invoke(name, new Object[0], kwargs);
+    }
+
+    @Override
+    public Object invoke(String name, Object[] args, Map<String, Object> kwargs) {
+        return call(request(INVOKE, name, args == null ? new Object[0] : args, kwargs));
+    }
+
+    @Override
+    public Object invokeMethod(String obj, String name, Object... args) {
+        return call(request(INVOKE_METHOD, obj, name, args));
+    }
+
+    @Override
+    public void exec(String str) {
+        broadcast(request(EXEC, str));
+    }
+
+    /** Stops the worker processes once their running calls are finished. */
+    @Override
+    public void close() {
+        closed = true;
+        for (Worker worker : workers) {
+            if (worker != null) {
+                worker.lock.lock();
+                try {
+                    worker.close();
+                } finally {
+                    worker.lock.unlock();
+                }
+            }
+        }
+    }
+
+    private static Encoder request(int op, Object... operands) {
+        Encoder encoder = new Encoder();
+        encoder.writeByte(TUPLE);
+        encoder.writeInt(operands.length + 1);
+        encoder.writeByte(INT);
+        encoder.writeLong(op);
+        for (Object operand : operands) {
+            encoder.encode(operand);
+        }
+        return encoder;
+    }
+
+    /**
+     * Runs the request on an idle worker, or waits for one if all of them are busy. The stopped
+     * workers are skipped, so that the request only fails if all of them are stopped.
+     */
+    private Object call(Encoder request) {
+        int start = Math.floorMod(next.getAndIncrement(), workers.length);
+        for (int i = 0; i < workers.length; i++) {
+            Worker worker = workers[(start + i) % workers.length];
+            if (!worker.stopped && worker.lock.tryLock()) {
+                try {
+                    if (!worker.stopped) {
+                        return worker.call(request);
+                    }
+                } finally {
+                    worker.lock.unlock();
+                }
+            }
+        }
+
+        for (int i = 0; i < workers.length; i++) {
+            Worker worker = workers[(start + i) % workers.length];
+            if (!worker.stopped) {
+                worker.lock.lock();
+                try {
+                    // the worker may have stopped while waiting for it
+                    if (!worker.stopped) {
+                        return worker.call(request);
+                    }
+                } finally {
+                    worker.lock.unlock();
+                }
+            }
+        }
+
+        checkRunning();
+        throw new IllegalStateException("All the Python worker processes have been stopped.");
+    }
+
+    /**
+     * Runs the request on every running worker in turn. The interpreter is closed if the request
+     * fails in some of the workers only, since the global variables of the workers differ then.
+     * The workers stopping meanwhile don't run any request later, so they are skipped.
+     */
+    private void broadcast(Encoder request) {
+        List<Integer> failed = new ArrayList<>();
+        RuntimeException error = null;
+        int running = 0;
+        for (int i = 0; i < workers.length; i++) {
+            Worker worker = workers[i];
+            worker.lock.lock();
+            try {
+                if (!worker.stopped) {
+                    running++;
+                    worker.call(request);
+                }
+            } catch (RuntimeException e) {
+                if (worker.stopped && !closed) {
+                    running--;
+                    continue;
+                }
+                failed.add(i);
+                if (error == null) {
+                    error = e;
+                } else {
+                    error.addSuppressed(e);
+                }
+            } finally {
+                worker.lock.unlock();
+            }
+        }
+
+        if (error == null && running > 0) {
+            return;
+        } else if (error == null) {
+            checkRunning();
+            throw new IllegalStateException("All the Python worker processes have been stopped.");
+        } else if (failed.size() == running) {
+            throw error;
+        }
+        close();
+        throw new IllegalStateException(
+                String.format(
+                        "The request failed in the Python worker processes %s of %d, so the "
+                                + "interpreter has been closed.",
+                        failed, workers.length),
+                error);
+    }
+
+    private void checkRunning() {
+        if (closed) {
+            throw new IllegalStateException("The interpreter has been closed.");
+        }
+    }
+
+    private static <T> T convert(Object value, Class<T> clazz) {
+        if (value instanceof Number && !clazz.isInstance(value)) {
+            Number number = (Number) value;
+            if (clazz == Integer.class) {
+                return clazz.cast(number.intValue());
+            } else if (clazz == Long.class) {
+                return clazz.cast(number.longValue());
+            } else if (clazz == Short.class) {
+                return clazz.cast(number.shortValue());
+            } else if (clazz == Byte.class) {
+                return clazz.cast(number.byteValue());
+            } else if (clazz == Double.class) {
+                return clazz.cast(number.doubleValue());
+            } else if (clazz == Float.class) {
+                return clazz.cast(number.floatValue());
+            }
+        }
+        return clazz.cast(value);
+    }
+
+    /** A worker process and the shared memory exchanging the calls with it. */
+    private final class Worker {
+        private final ReentrantLock lock = new ReentrantLock();
+
+        private final File file;
+
+        private final Process process;
+
+        private final Ring requests;
+
+        private final Ring responses;
+
+        /** The stdin of the worker, which exits once it is closed. */
+        private final OutputStream stdin;
+
+        private volatile boolean stopped;
+
+        private Worker(PythonInterpreterConfig config) throws IOException {
+            // prefers the memory file system of Linux to avoid writing back the rings to disk
+            File directory = new File("/dev/shm");
+            file =
+                    (directory.isDirectory()
+                                    ? Files.createTempFile(directory.toPath(), "pemja_", ".ring")
+                                    : Files.createTempFile("pemja_", ".ring"))
+                            .toFile();
+            file.deleteOnExit();
+
+            MappedByteBuffer buffer;
+            try (RandomAccessFile raf = new RandomAccessFile(file, "rw")) {
+                raf.setLength(2L * RING_SIZE);
+                buffer = raf.getChannel().map(FileChannel.MapMode.READ_WRITE, 0, 2L * RING_SIZE);
+            }
+            requests = new Ring(buffer, 0);
+            responses = new Ring(buffer, RING_SIZE);
+
+            String pythonExec = config.getPythonExec();
+            String script =
+                    String.join(
+                            File.separator,
+                            CommonUtils.INSTANCE.getPemJaModulePath(pythonExec),
+                            WORKER_SCRIPT);
+            ProcessBuilder builder =
+                    new ProcessBuilder(
+                            pythonExec == null
+                                    ? CommonUtils.INSTANCE.getPythonCommand()
+                                    : pythonExec,
+                            script,
+                            file.getAbsolutePath(),
+                            String.valueOf(RING_CAPACITY));
+            builder.redirectOutput(ProcessBuilder.Redirect.INHERIT);
+            builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+            if (config.getWorkingDirectory() != null) {
+                builder.directory(new File(config.getWorkingDirectory()));
+            }
+            if (config.getPythonHome() != null) {
+                builder.environment().put("PYTHONHOME", config.getPythonHome());
+            }
+            List<String> paths = new ArrayList<>(Arrays.asList(config.getPaths()));
+            String pythonPath = builder.environment().get("PYTHONPATH");
+            if (pythonPath != null) {
+                paths.add(pythonPath);
+            }
+            if (!paths.isEmpty()) {
+                builder.environment().put("PYTHONPATH", String.join(File.pathSeparator, paths));
+            }
+
+            try {
+                process = builder.start();
+            } catch (IOException e) {
+                Files.deleteIfExists(file.toPath());
+                throw e;
+            }
+            stdin = process.getOutputStream();
+        }
+
+        private Object call(Encoder request) {
+            checkRunning();
+            if (stopped) {
+                throw new IllegalStateException("The Python worker process has been stopped.");
+            }
+
+            requests.write(request.buffer, request.size);
+            byte[] response = responses.read(process);
+            if (response == null) {
+                stopped = true;
+                throw new IllegalStateException(
+                        "The Python worker process has exited unexpectedly.");
+            }
+
+            Object[] result = (Object[]) new Decoder(response).decode();
+            if ((Boolean) result[0]) {
+                return result[1];
+            }
+            throw new RuntimeException(new PythonException(result[1] + "\n" + result[2]));
+        }
+
+        private void close() {
+            stopped = true;
+            try {
+                // the worker exits once its stdin is closed
+                stdin.close();
+                if (!process.waitFor(10, TimeUnit.SECONDS)) {
+                    process.destroyForcibly();
+                }
+            } catch (IOException e) {
+                process.destroyForcibly();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                process.destroyForcibly();
+            } finally {
+                file.delete();
+            }
+        }
+    }
+
+    /**
+     * A single producer and single consumer ring buffer in the shared memory. The positions are
+     * stored and waited for through {@link Futex}, which orders them with the copies of the data.
+     */
+    private static final class Ring {
+        private final ByteBuffer buffer;
+
+        private Ring(ByteBuffer buffer, int offset) {
+            ByteBuffer duplicate = buffer.duplicate();
+            duplicate.position(offset);
+            duplicate.limit(offset + RING_SIZE);
+            this.buffer = duplicate.slice().order(ByteOrder.LITTLE_ENDIAN);
+        }
+
+        private void write(byte[] data, int length) {
+            long tail = Futex.load(buffer, TAIL_OFFSET);
+            long head = Futex.load(buffer, HEAD_OFFSET);
+            if (4L + length > RING_CAPACITY - (tail - head)) {
+                throw new IllegalArgumentException(
+                        String.format(
+                                "The message of %d bytes exceeds the ring buffer of %d bytes.",
+                                length, RING_CAPACITY));
+            }
+            byte[] header = new byte[4];
+            ByteBuffer.wrap(header).order(ByteOrder.LITTLE_ENDIAN).putInt(length);
+            copy(tail, header, 4, true);
+            copy(tail + 4, data, length, true);
+            // publishes the message and wakes up the consumer
+            Futex.store(buffer, TAIL_OFFSET, tail + 4 + length);
+        }
+
+        /** Waits for a message, or returns null if the producer exits meanwhile. */
+        private byte[] read(Process producer) {
+            long head = Futex.load(buffer, HEAD_OFFSET);
+            while (Futex.await(buffer, TAIL_OFFSET, head, WAIT_NANOS) == head) {
+                if (!producer.isAlive()) {
+                    return null;
+                }
+            }
+
+            byte[] header = new byte[4];
+            copy(head, header, 4, false);
+            int length = ByteBuffer.wrap(header).order(ByteOrder.LITTLE_ENDIAN).getInt();
+            byte[] data = new byte[length];
+            copy(head + 4, data, length, false);
+            Futex.store(buffer, HEAD_OFFSET, head + 4 + length);
+            return data;
+        }
+
+        /** Copies the bytes from or to the data at the position, wrapping around its end. */
+        private void copy(long position, byte[] bytes, int length, boolean write) {
+            int index = (int) (position % RING_CAPACITY);
+            int first = Math.min(length, RING_CAPACITY - index);
+            ByteBuffer data = buffer.duplicate();
+            data.position(DATA_OFFSET + index);
+            if (write) {
+                data.put(bytes, 0, first);
+            } else {
+                data.get(bytes, 0, first);
+            }
+            if (first < length) {
+                data.position(DATA_OFFSET);
+                if (write) {
+                    data.put(bytes, first, length - first);
+                } else {
+                    data.get(bytes, first, length - first);
+                }
+            }
+        }
+    }
+
+    /** Encodes the Java objects passed to the workers. */
+    private static final class Encoder {
+        private byte[] buffer = new byte[256];
+
+        private int size;
+
+        private void encode(Object value) {
+            if (value == null) {
+                writeByte(NONE);
+            } else if (value instanceof Boolean) {
+                writeByte((Boolean) value ? TRUE : FALSE);
+            } else if (value instanceof Long
+                    || value instanceof Integer
+                    || value instanceof Short
+                    || value instanceof Byte) {
+                writeByte(INT);
+                writeLong(((Number) value).longValue());
+            } else if (value instanceof BigInteger) {
+                BigInteger integer = (BigInteger) value;
+                if (integer.bitLength() < 64) {
+                    writeByte(INT);
+                    writeLong(integer.longValue());
+                } else {
+                    writeByte(BIG_INT);
+                    writeString(integer.toString());
+                }
+            } else if (value instanceof Double || value instanceof Float) {
+                writeByte(FLOAT);
+                writeLong(Double.doubleToRawLongBits(((Number) value).doubleValue()));
+            } else if (value instanceof String || value instanceof Character) {
+                writeByte(STR);
+                writeString(value.toString());
+            } else if (value instanceof BigDecimal) {
+                writeByte(DECIMAL);
+                writeString(value.toString());
+            } else if (value instanceof byte[]) {
+                byte[] bytes = (byte[]) value;
+                writeByte(BYTES);
+                writeInt(bytes.length);
+                writeBytes(bytes);
+            } else if (value.getClass().isArray()) {
+                int length = Array.getLength(value);
+                writeByte(TUPLE);
+                writeInt(length);
+                for (int i = 0; i < length; i++) {
+                    encode(Array.get(value, i));
+                }
+            } else if (value instanceof Collection) {
+                Collection<?> collection = (Collection<?>) value;
+                writeByte(LIST);
+                writeInt(collection.size());
+                for (Object item : collection) {
+                    encode(item);
+                }
+            } else if (value instanceof Map) {
+                Map<?, ?> map = (Map<?, ?>) value;
+                writeByte(DICT);
+                writeInt(map.size());
+                for (Map.Entry<?, ?> entry : map.entrySet()) {
+                    encode(entry.getKey());
+                    encode(entry.getValue());
+                }
+            } else {
+                throw new IllegalArgumentException(
+                        "The object of "
+                                + value.getClass().getName()
+                                + " can't be passed to a Python worker process.");
+            }
+        }
+
+        private void writeString(String value) {
+            byte[] bytes = value.getBytes(StandardCharsets.UTF_8);
+            writeInt(bytes.length);
+            writeBytes(bytes);
+        }
+
+        private void writeByte(int value) {
+            ensureCapacity(1);
+            buffer[size++] = (byte) value;
+        }
+
+        private void writeInt(int value) {
+            ensureCapacity(4);
+            for (int i = 0; i < 4; i++) {
+                buffer[size++] = (byte) (value >>> (i * 8));
+            }
+        }
+
+        private void writeLong(long value) {
+            ensureCapacity(8);
+            for (int i = 0; i < 8; i++) {
+                buffer[size++] = (byte) (value >>> (i * 8));
+            }
+        }
+
+        private void writeBytes(byte[] bytes) {
+            ensureCapacity(bytes.length);
+            System.arraycopy(bytes, 0, buffer, size, bytes.length);
+            size += bytes.length;
+        }
+
+        private void ensureCapacity(int length) {
+            if (size + length > buffer.length) {
+                buffer = Arrays.copyOf(buffer, Math.max(buffer.length * 2, size + length));
+            }
+        }
+    }
+
+    /** Decodes the Python objects returned from the workers. */
+    private static final class Decoder {
+        private final ByteBuffer buffer;
+
+        private Decoder(byte[] data) {
+            this.buffer = ByteBuffer.wrap(data).order(ByteOrder.LITTLE_ENDIAN);
+        }
+
+        private Object decode() {
+            byte tag = buffer.get();
+            switch (tag) {
+                case NONE:
+                    return null;
+                case FALSE:
+                    return false;
+                case TRUE:
+                    return true;
+                case INT:
+                    return buffer.getLong();
+                case BIG_INT:
+                    return new BigInteger(readString());
+                case FLOAT:
+                    return buffer.getDouble();
+                case STR:
+                    return readString();
+                case BYTES:
+                    {
+                        byte[] bytes = new byte[buffer.getInt()];
+                        buffer.get(bytes);
+                        return bytes;
+                    }
+                case LIST:
+                    {
+                        int length = buffer.getInt();
+                        List<Object> list = new ArrayList<>(length);
+                        for (int i = 0; i < length; i++) {
+                            list.add(decode());
+                        }
+                        return list;
+                    }
+                case TUPLE:
+                    {
+                        Object[] tuple = new Object[buffer.getInt()];
+                        for (int i = 0; i < tuple.length; i++) {
+                            tuple[i] = decode();
+                        }
+                        return tuple;
+                    }
+                case DICT:
+                    {
+                        int length = buffer.getInt();
+                        Map<Object, Object> map = new HashMap<>();
+                        for (int i = 0; i < length; i++) {
+                            Object key = decode();
+                            map.put(key, decode());
+                        }
+                        return map;
+                    }
+                case DECIMAL:
+                    return new BigDecimal(readString());
+                default:
+                    throw new IllegalStateException("Unknown tag " + tag + " of the value.");
+            }
+        }
+
+        private String readString() {
+            byte[] bytes = new byte[buffer.getInt()];
+            buffer.get(bytes);
+            return new String(bytes, StandardCharsets.UTF_8);
+        }
+    }
+}
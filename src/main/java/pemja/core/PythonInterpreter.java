@@ -16,18 +16,37 @@
 
 package pemja.core;
 
+import pemja.core.object.PyObject;
 import pemja.utils.CommonUtils;
 
 import java.io.File;
 import java.io.Serializable;
+import java.time.Duration;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.List;
 import java.util.Map;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.ScheduledThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.function.Supplier;
 
 /** The Interpreter implementation for Python Interpreter. */
 public final class PythonInterpreter implements Interpreter {
 
     private static final long serialVersionUID = 1L;
 
+    /**
+     * The thread interrupting the calls which haven't returned within their deadlines, which also
+     * finalizes the idle sub interpreters once they expire.
+     */
+    private static final ScheduledThreadPoolExecutor WATCHDOG = createWatchdog();
+
     private final MainInterpreter mainInterpreter = MainInterpreter.instance;
 
     /**
@@ -36,6 +55,22 @@ public final class PythonInterpreter implements Interpreter {
      */
     private long tState = 0;
 
+    /** The open session holding the Python thread state, if any. */
+    private volatile PythonSession session;
+
+    /** The config of this interpreter if it is recycled once it is closed, otherwise null. */
+    private PythonInterpreterConfig recycledConfig;
+
+    /** Guards the interrupts of other threads against closing this interpreter. */
+    private final Object interruptLock = new Object();
+
+    /** The number of the calls with deadlines, which identifies them to the watchdog. */
+    private long deadlineCalls;
+
+    /** The conversion policy of Java collections passed to Python. */
+    private PythonInterpreterConfig.ConversionPolicy conversionPolicy =
+            PythonInterpreterConfig.ConversionPolicy.LAZY_PROXY;
+
     /**
      * Creates a new PythonInterpreter instance.
      *
@@ -94,6 +129,51 @@ public final class PythonInterpreter implements Interpreter {
         return invoke(name, args, null);
     }
 
+    /**
+     * Invokes a callable function with a variable number of arguments args, converting the Java
+     * collections passed to Python during this call with the given {@link
+     * PythonInterpreterConfig.ConversionPolicy} instead of the one of this interpreter.
+     *
+     * @param policy the conversion policy of Java collections used by this call
+     * @param name the function name
+     * @param args the variable number of arguments
+     * @return the function result
+     */
+    public Object invoke(
+            PythonInterpreterConfig.ConversionPolicy policy, String name, Object... args) {
+        checkPythonInterpreterRunning();
+        if (policy == conversionPolicy) {
+            return invoke(name, args);
+        }
+        setConversionPolicy(tState, policy.ordinal());
+        try {
+            return invoke(name, args);
+        } finally {
+            setConversionPolicy(tState, conversionPolicy.ordinal());
+        }
+    }
+
+    /**
+     * Invokes a coroutine function, i.e. an {@code async def} function, with a variable number of
+     * arguments args without waiting for its coroutine. The coroutines run in the asyncio event
+     * loop of this interpreter, whose thread is started by the first call and stopped once this
+     * interpreter is closed, so the coroutines of the calls overlap while they are awaiting I/O.
+     *
+     * <p>The returned future is completed in the thread of the event loop, so the dependent stages
+     * which block should be added by the async methods of {@link CompletableFuture}. The future
+     * is cancelled if this interpreter is closed before the coroutine is done.
+     *
+     * @param name the function name
+     * @param args the variable number of arguments
+     * @return the future of the coroutine result
+     */
+    public CompletableFuture<Object> invokeAsync(String name, Object... args) {
+        checkPythonInterpreterRunning();
+        CompletableFuture<Object> future = new CompletableFuture<>();
+        invokeAsync(tState, name, args, future);
+        return future;
+    }
+
     @Override
     public Object invoke(String name, Map<String, Object> kwargs) {
         return invoke(name, null, kwargs);
@@ -118,20 +198,185 @@ public final class PythonInterpreter implements Interpreter {
         }
     }
 
+    /**
+     * Invokes a callable function with a variable number of arguments args, which is interrupted
+     * with a {@link PythonTimeoutException} if it doesn't return within the timeout. The
+     * interpreter can still be used after the call is interrupted.
+     *
+     * <p>The call is only interrupted while it runs Python code, e.g. a call blocked in {@code
+     * time.sleep} is interrupted once the sleep returns.
+     *
+     * <p>The interrupt is raised in the Python thread state of the current thread, which is
+     * ambiguous for a {@link PythonInterpreterConfig.ExecType#MULTI_THREAD} interpreter if another
+     * one has been created on the current thread after it, so the call is rejected with an {@link
+     * IllegalStateException} while the later one is open.
+     *
+     * @param timeout the timeout of the call
+     * @param name the function name
+     * @param args the variable number of arguments
+     * @return the function result
+     * @throws PythonTimeoutException if the call is interrupted
+     */
+    public Object invoke(Duration timeout, String name, Object... args)
+            throws PythonTimeoutException {
+        return invokeWithDeadline(timeout, () -> invoke(name, args));
+    }
+
+    /**
+     * Invokes a method of a Python object with a variable number of arguments args, which is
+     * interrupted with a {@link PythonTimeoutException} if it doesn't return within the timeout.
+     *
+     * @param timeout the timeout of the call
+     * @param obj the name of the Python object
+     * @param name the method name
+     * @param args the variable number of arguments
+     * @return the method result
+     * @throws PythonTimeoutException if the call is interrupted
+     * @see #invoke(Duration, String, Object...)
+     */
+    public Object invokeMethod(Duration timeout, String obj, String name, Object... args)
+            throws PythonTimeoutException {
+        return invokeWithDeadline(timeout, () -> invokeMethod(obj, name, args));
+    }
+
     @Override
     public void exec(String str) {
         checkPythonInterpreterRunning();
         exec(tState, str);
     }
 
+    /**
+     * Interrupts the call running in this interpreter with a {@link PythonTimeoutException}, which
+     * can be called by any thread. Like {@link Thread#interrupt()}, if no call is running, the next
+     * call is interrupted once it runs Python code.
+     *
+     * <p>The Python code can catch the interrupt as {@code pemja.PythonTimeoutError}, which derives
+     * from {@code BaseException} rather than {@code Exception}.
+     */
+    public void interrupt() {
+        interrupt(0);
+    }
+
+    /**
+     * Sets the {@link PythonInterpreterConfig.ConversionPolicy} of the Java collections passed to
+     * Python by the subsequent calls.
+     *
+     * @param policy the conversion policy of Java collections
+     */
+    public void setConversionPolicy(PythonInterpreterConfig.ConversionPolicy policy) {
+        checkPythonInterpreterRunning();
+        setConversionPolicy(tState, policy.ordinal());
+        this.conversionPolicy = policy;
+    }
+
+    /**
+     * Imports a record batch exported through the <a
+     * href="https://arrow.apache.org/docs/format/CDataInterface.html">Arrow C Data Interface</a>
+     * as a {@code pyarrow.RecordBatch}, e.g. the addresses of the {@code ArrowArray} and {@code
+     * ArrowSchema} filled by {@code Data.exportVectorSchemaRoot} of Arrow Java.
+     *
+     * <p>No data is copied. The ownership of both structs is moved to Python, whose release
+     * callbacks are invoked once the returned {@link PyObject} is closed and the record batch is
+     * no longer referenced in Python, so the caller must not release them again. The returned
+     * {@link PyObject} can be passed to {@link #invoke} directly and the record batch returned by
+     * Python can be exported back with {@link PyObject#exportRecordBatch(long, long)}.
+     *
+     * <p>{@code pyarrow} is an optional dependency which is only required by this method.
+     *
+     * @param arrayAddress the memory address of the {@code ArrowArray}
+     * @param schemaAddress the memory address of the {@code ArrowSchema}
+     * @return the {@link PyObject} wrapping the imported {@code pyarrow.RecordBatch}
+     */
+    public PyObject importRecordBatch(long arrayAddress, long schemaAddress) {
+        checkPythonInterpreterRunning();
+        return importRecordBatch(tState, arrayAddress, schemaAddress);
+    }
+
+    /**
+     * Returns a Java object implementing the functional interface, e.g. {@link
+     * java.util.function.Function} or {@link java.util.function.Predicate}, by calling the Python
+     * callable directly instead of looking it up by name on every call. It can be passed to Java
+     * streams or caches, e.g. {@code Map.computeIfAbsent}, in the thread of this interpreter.
+     *
+     * @param iface the functional interface
+     * @param callable the Python callable
+     * @return the implementation of the functional interface
+     */
+    public <T> T asInterface(Class<T> iface, PyObject callable) {
+        checkPythonInterpreterRunning();
+        return callable.asInterface(iface);
+    }
+
+    /**
+     * Returns a Java object implementing the functional interface by calling the Python callable
+     * of the given name in the global scope of this interpreter.
+     *
+     * @param iface the functional interface
+     * @param name the name of the Python callable
+     * @return the implementation of the functional interface
+     */
+    public <T> T asInterface(Class<T> iface, String name) {
+        Object callable = get(name);
+        if (!(callable instanceof PyObject)) {
+            throw new IllegalArgumentException(name + " is not a Python callable.");
+        }
+        return asInterface(iface, (PyObject) callable);
+    }
+
+    /**
+     * Opens a {@link PythonSession}, which holds the Python thread state of this interpreter until
+     * it is closed, so that the calls in the session don't acquire it one by one. Only the
+     * current thread can use the interpreter until the session is closed.
+     *
+     * @return the session, which must be closed by the current thread
+     */
+    public synchronized PythonSession session() {
+        checkPythonInterpreterRunning();
+        if (session != null) {
+            throw new IllegalStateException("A session of the interpreter is already open.");
+        }
+        beginSession(tState);
+        session = new PythonSession(this, Thread.currentThread());
+        return session;
+    }
+
+    /** Releases the Python thread state held by the session. */
+    void endSession(PythonSession session) {
+        if (this.session == session) {
+            this.session = null;
+            endSession(tState);
+        }
+    }
+
     @Override
     public void close() {
+        PythonSession session = this.session;
+        if (session != null) {
+            session.close();
+        }
         if (tState > 0) {
-            try {
-                finalize(tState);
-            } finally {
-                tState = 0;
+            synchronized (interruptLock) {
+                try {
+                    if (recycledConfig != null && restoreGlobals(tState)) {
+                        detach(tState);
+                        if (IdleInterpreters.instance.offer(recycledConfig, tState)) {
+                            // finalizes the interpreter unless it is reused meanwhile
+                            WATCHDOG.schedule(
+                                    this::finalizeExpiredInterpreters,
+                                    recycledConfig.getIdleInterpreterTtl().toNanos(),
+                                    TimeUnit.NANOSECONDS);
+                        } else {
+                            attach(tState);
+                            finalize(tState);
+                        }
+                    } else {
+                        finalize(tState);
+                    }
+                } finally {
+                    tState = 0;
+                }
             }
+            finalizeExpiredInterpreters();
         }
     }
 
@@ -141,14 +386,64 @@ public final class PythonInterpreter implements Interpreter {
      * @param config the specified {@link PythonInterpreterConfig}.
      */
     private void initialize(PythonInterpreterConfig config) {
+        if (config.getExecType() == PythonInterpreterConfig.ExecType.PROCESS) {
+            throw new IllegalArgumentException(
+                    "The PROCESS exec type is only supported by ProcessPythonInterpreter.");
+        }
         mainInterpreter.initialize(config);
+
+        boolean recyclable = isRecyclable(config);
+        if (recyclable) {
+            finalizeExpiredInterpreters();
+            IdleInterpreter idle = IdleInterpreters.instance.poll(config);
+            if (idle != null) {
+                attach(idle.tState);
+                this.tState = idle.tState;
+                this.recycledConfig = config;
+                setConversionPolicy(config.getConversionPolicy());
+                return;
+            }
+        }
+
         this.tState = init(config.getExecType().ordinal());
+        setConversionPolicy(config.getConversionPolicy());
 
         synchronized (PythonInterpreter.class) {
             configSearchPaths(config);
         }
 
         exec("from pemja import logger");
+
+        String warmUpCode = config.getWarmUpCode();
+        if (warmUpCode != null) {
+            PythonInterpreterConfig.ExecType execType = config.getExecType();
+            if (execType == PythonInterpreterConfig.ExecType.MULTI_THREAD
+                    || execType == PythonInterpreterConfig.ExecType.FREE_THREADED) {
+                execTemplate(tState, warmUpCode);
+            } else {
+                exec(warmUpCode);
+            }
+        }
+
+        if (recyclable && saveGlobals(tState)) {
+            this.recycledConfig = config;
+        }
+    }
+
+    /** Whether the interpreters of the config are kept idle for reuse once they are closed. */
+    private static boolean isRecyclable(PythonInterpreterConfig config) {
+        PythonInterpreterConfig.ExecType execType = config.getExecType();
+        return config.getMaxIdleInterpreters() > 0
+                && (execType == PythonInterpreterConfig.ExecType.SUB_INTERPRETER
+                        || execType == PythonInterpreterConfig.ExecType.SUB_INTERPRETER_OWN_GIL);
+    }
+
+    /** Finalizes the idle interpreters which have expired, in the current thread. */
+    private void finalizeExpiredInterpreters() {
+        for (long expired : IdleInterpreters.instance.expire()) {
+            attach(expired);
+            finalize(expired);
+        }
     }
 
     /** Config Search Paths in the current {@link PythonInterpreter} instance */
@@ -172,12 +467,55 @@ public final class PythonInterpreter implements Interpreter {
         }
     }
 
+    /** Runs the call, which is interrupted by the watchdog once the timeout passes. */
+    private Object invokeWithDeadline(Duration timeout, Supplier<Object> call)
+            throws PythonTimeoutException {
+        checkPythonInterpreterRunning();
+        long id = ++deadlineCalls;
+        long enclosing = armInterrupt(tState, id);
+        ScheduledFuture<?> deadline =
+                WATCHDOG.schedule(() -> interrupt(id), timeout.toNanos(), TimeUnit.NANOSECONDS);
+        try {
+            return call.get();
+        } finally {
+            deadline.cancel(false);
+            disarmInterrupt(tState, enclosing);
+        }
+    }
+
+    /** Interrupts the call of the id, or any call if the id is 0, unless this is closed. */
+    private void interrupt(long id) {
+        synchronized (interruptLock) {
+            if (tState > 0) {
+                interrupt(tState, id);
+            }
+        }
+    }
+
+    private static ScheduledThreadPoolExecutor createWatchdog() {
+        ScheduledThreadPoolExecutor watchdog =
+                new ScheduledThreadPoolExecutor(
+                        1,
+                        runnable -> {
+                            Thread thread = new Thread(runnable, "PemJaWatchdog");
+                            thread.setDaemon(true);
+                            return thread;
+                        });
+        // most calls return within their deadlines, which are cancelled then
+        watchdog.setRemoveOnCancelPolicy(true);
+        return watchdog;
+    }
+
     /** Checks if the python interpreter is running. */
     private void checkPythonInterpreterRunning() {
         if (tState == 0) {
             throw new RuntimeException(
                     "The python interpreter has not been started. You need to call the `open` method before.");
         }
+        PythonSession session = this.session;
+        if (session != null) {
+            session.checkThread();
+        }
     }
 
     /**
@@ -257,6 +595,85 @@ public final class PythonInterpreter implements Interpreter {
      */
     private native void finalize(long tState);
 
+    /**
+     * Sets the conversion policy of Java collections in the JcpThread.
+     *
+     * @param tState the JcpThread
+     * @param policy the ordinal of the conversion policy
+     */
+    private native void setConversionPolicy(long tState, int policy);
+
+    /**
+     * Acquires the PyThreadState of the JcpThread until {@link #endSession(long)} is called.
+     *
+     * @param tState the JcpThread
+     */
+    private native void beginSession(long tState);
+
+    /**
+     * Releases the PyThreadState of the JcpThread acquired by {@link #beginSession(long)}.
+     *
+     * @param tState the JcpThread
+     */
+    private native void endSession(long tState);
+
+    /**
+     * Saves a copy of the globals of the JcpThread, which {@link #restoreGlobals(long)} restores.
+     *
+     * @param tState the JcpThread
+     * @return whether the globals have been saved
+     */
+    private native boolean saveGlobals(long tState);
+
+    /**
+     * Restores the globals of the JcpThread saved by {@link #saveGlobals(long)}.
+     *
+     * @param tState the JcpThread
+     * @return whether the globals have been restored
+     */
+    private native boolean restoreGlobals(long tState);
+
+    /**
+     * Deletes the PyThreadState of the JcpThread of a sub interpreter, which must be owned by the
+     * current thread, so that the JcpThread can be attached to any thread.
+     *
+     * @param tState the JcpThread
+     */
+    private native void detach(long tState);
+
+    /**
+     * Attaches the JcpThread detached by {@link #detach(long)} to the current thread.
+     *
+     * @param tState the JcpThread
+     */
+    private native void attach(long tState);
+
+    /**
+     * Raises the PythonTimeoutError in the JcpThread from another thread.
+     *
+     * @param tState the JcpThread
+     * @param id the id of the interrupted call, or 0 to interrupt any call
+     */
+    private native void interrupt(long tState, long id);
+
+    /**
+     * Arms the call of the id to be interrupted by {@link #interrupt(long, long)}.
+     *
+     * @param tState the JcpThread
+     * @param id the id of the call
+     * @return the id of the enclosing armed call, or 0
+     */
+    private native long armInterrupt(long tState, long id);
+
+    /**
+     * Disarms the call armed by {@link #armInterrupt(long, long)} and drops its interrupt if it
+     * hasn't been raised yet.
+     *
+     * @param tState the JcpThread
+     * @param enclosing the id of the enclosing armed call to arm again
+     */
+    private native void disarmInterrupt(long tState, long enclosing);
+
     /*--------- Set/Get the Java Object into JcpThread variable tables -------------*/
 
     private native void set(long tState, String name, boolean value);
@@ -294,6 +711,9 @@ public final class PythonInterpreter implements Interpreter {
     private native Object invoke(
             long tState, String name, Object[] args, Map<String, Object> kwargs);
 
+    private native void invokeAsync(
+            long tState, String name, Object[] args, CompletableFuture<Object> future);
+
     /*---------------------------------------------------------------------------------------*/
 
     /*------------------------- Invokes the method of a called object -----------------------*/
@@ -320,6 +740,15 @@ public final class PythonInterpreter implements Interpreter {
 
     /*---------------------------------------------------------------------------------------*/
 
+    /**
+     * Imports the Arrow C Data Interface structs as a {@code pyarrow.RecordBatch}.
+     *
+     * @param tState the JcpThread
+     * @param arrayAddress the memory address of the {@code ArrowArray}
+     * @param schemaAddress the memory address of the {@code ArrowSchema}
+     */
+    private native PyObject importRecordBatch(long tState, long arrayAddress, long schemaAddress);
+
     /**
      * Execute an arbitrary number of statements in the JcpThread.
      *
@@ -328,6 +757,75 @@ public final class PythonInterpreter implements Interpreter {
      */
     private native void exec(long tState, String code);
 
+    /**
+     * Executes the warm-up code once in a template namespace shared by the JcpThreads of the Main
+     * Interpreter, and copies the template into the globals of the JcpThread.
+     *
+     * @param tState the JcpThread
+     * @param code the warm-up code
+     */
+    private native void execTemplate(long tState, String code);
+
+    /** An idle sub interpreter kept for reuse. */
+    private static final class IdleInterpreter {
+        private final long tState;
+
+        private final long idleSince;
+
+        private IdleInterpreter(long tState, long idleSince) {
+            this.tState = tState;
+            this.idleSince = idleSince;
+        }
+    }
+
+    /**
+     * The idle sub interpreters of the process, which are grouped by their configs. The most
+     * recently closed interpreter of a config is reused first.
+     */
+    private static final class IdleInterpreters {
+
+        private static final IdleInterpreters instance = new IdleInterpreters();
+
+        private final Map<PythonInterpreterConfig, Deque<IdleInterpreter>> interpreters =
+                new HashMap<>();
+
+        /** Returns an idle interpreter of the config, or null if there is none. */
+        synchronized IdleInterpreter poll(PythonInterpreterConfig config) {
+            Deque<IdleInterpreter> idle = interpreters.get(config);
+            return idle == null ? null : idle.pollFirst();
+        }
+
+        /** Keeps the closed interpreter, unless the config has enough idle interpreters. */
+        synchronized boolean offer(PythonInterpreterConfig config, long tState) {
+            Deque<IdleInterpreter> idle =
+                    interpreters.computeIfAbsent(config, k -> new ArrayDeque<>());
+            if (idle.size() >= config.getMaxIdleInterpreters()) {
+                return false;
+            }
+            idle.addFirst(new IdleInterpreter(tState, System.nanoTime()));
+            return true;
+        }
+
+        /** Removes and returns the interpreters which have been idle longer than their TTL. */
+        synchronized List<Long> expire() {
+            List<Long> expired = new ArrayList<>();
+            long now = System.nanoTime();
+            for (Map.Entry<PythonInterpreterConfig, Deque<IdleInterpreter>> entry :
+                    interpreters.entrySet()) {
+                long ttl = entry.getKey().getIdleInterpreterTtl().toNanos();
+                Iterator<IdleInterpreter> iterator = entry.getValue().iterator();
+                while (iterator.hasNext()) {
+                    IdleInterpreter idle = iterator.next();
+                    if (now - idle.idleSince >= ttl) {
+                        iterator.remove();
+                        expired.add(idle.tState);
+                    }
+                }
+            }
+            return expired;
+        }
+    }
+
     /**
      * The main Python interpreter that all sub-interpreters will be created from. The
      * MainInterpreter is used to avoid potential deadlocks. Python can deadlock when trying to
@@ -17,8 +17,10 @@
 package pemja.core;
 
 import java.io.File;
+import java.time.Duration;
 import java.util.Arrays;
 import java.util.LinkedHashSet;
+import java.util.Objects;
 import java.util.Set;
 
 /**
@@ -55,17 +57,37 @@ public final class PythonInterpreterConfig {
     /** Defines the execution type of python interpreter. */
     private final ExecType execType;
 
+    /** Defines how Java collections are converted to Python objects. */
+    private final ConversionPolicy conversionPolicy;
+
+    /** Defines the code which runs once an interpreter is created. */
+    private final String warmUpCode;
+
+    /** Defines the maximum number of idle sub interpreters kept for reuse. */
+    private final int maxIdleInterpreters;
+
+    /** Defines how long an idle sub interpreter is kept for reuse. */
+    private final Duration idleInterpreterTtl;
+
     private PythonInterpreterConfig(
             String pythonHome,
             String workingDirectory,
             String[] paths,
             String pythonExec,
-            ExecType execType) {
+            ExecType execType,
+            ConversionPolicy conversionPolicy,
+            String warmUpCode,
+            int maxIdleInterpreters,
+            Duration idleInterpreterTtl) {
         this.pythonHome = pythonHome;
         this.workingDirectory = workingDirectory;
         this.paths = paths;
         this.pythonExec = pythonExec;
         this.execType = execType;
+        this.conversionPolicy = conversionPolicy;
+        this.warmUpCode = warmUpCode;
+        this.maxIdleInterpreters = maxIdleInterpreters;
+        this.idleInterpreterTtl = idleInterpreterTtl;
     }
 
     /** Returns the python home. */
@@ -93,6 +115,61 @@ public final class PythonInterpreterConfig {
         return execType;
     }
 
+    /** Returns the conversion policy of Java collections. */
+    public ConversionPolicy getConversionPolicy() {
+        return conversionPolicy;
+    }
+
+    /** Returns the code which runs once an interpreter is created. */
+    public String getWarmUpCode() {
+        return warmUpCode;
+    }
+
+    /** Returns the maximum number of idle sub interpreters kept for reuse. */
+    public int getMaxIdleInterpreters() {
+        return maxIdleInterpreters;
+    }
+
+    /** Returns how long an idle sub interpreter is kept for reuse. */
+    public Duration getIdleInterpreterTtl() {
+        return idleInterpreterTtl;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        if (this == o) {
+            return true;
+        }
+        if (o == null || getClass() != o.getClass()) {
+            return false;
+        }
+        PythonInterpreterConfig that = (PythonInterpreterConfig) o;
+        return maxIdleInterpreters == that.maxIdleInterpreters
+                && Objects.equals(pythonHome, that.pythonHome)
+                && Objects.equals(workingDirectory, that.workingDirectory)
+                && Arrays.equals(paths, that.paths)
+                && Objects.equals(pythonExec, that.pythonExec)
+                && execType == that.execType
+                && conversionPolicy == that.conversionPolicy
+                && Objects.equals(warmUpCode, that.warmUpCode)
+                && idleInterpreterTtl.equals(that.idleInterpreterTtl);
+    }
+
+    @Override
+    public int hashCode() {
+        int result =
+                Objects.hash(
+                        pythonHome,
+                        workingDirectory,
+                        pythonExec,
+                        execType,
+                        conversionPolicy,
+                        warmUpCode,
+                        maxIdleInterpreters,
+                        idleInterpreterTtl);
+        return 31 * result + Arrays.hashCode(paths);
+    }
+
     /** A builder for configuring the {@link PythonInterpreterConfig}. */
     public static PythonInterpreterConfigBuilder newBuilder() {
         return new PythonInterpreterConfigBuilder();
@@ -107,6 +184,14 @@ public final class PythonInterpreterConfig {
 
         private ExecType execType = ExecType.MULTI_THREAD;
 
+        private ConversionPolicy conversionPolicy = ConversionPolicy.LAZY_PROXY;
+
+        private String warmUpCode = null;
+
+        private int maxIdleInterpreters = 0;
+
+        private Duration idleInterpreterTtl = Duration.ofMinutes(1);
+
         /** Sets Python Home. */
         public PythonInterpreterConfigBuilder setPythonHome(String pythonHome) {
             this.pythonHome = pythonHome;
@@ -176,6 +261,58 @@ public final class PythonInterpreterConfig {
             return this;
         }
 
+        /** Configures how Java collections are converted to Python objects. */
+        public PythonInterpreterConfigBuilder setConversionPolicy(
+                ConversionPolicy conversionPolicy) {
+            this.conversionPolicy = conversionPolicy;
+            return this;
+        }
+
+        /**
+         * Configures the code which runs once an interpreter is created, e.g. to import the
+         * modules of the functions.
+         *
+         * <p>The {@link ExecType#MULTI_THREAD} and {@link ExecType#FREE_THREADED} interpreters
+         * share the modules of the Main Interpreter, so the code only runs once in a template
+         * namespace, and every interpreter with the same code starts with a shallow copy of the
+         * template as its global variables. The functions defined at the top level of the code are
+         * copied to use the global variables of the interpreter, while the other objects, e.g. the
+         * classes, are shared by the interpreters. A sub interpreter runs the code in its own
+         * global variables.
+         */
+        public PythonInterpreterConfigBuilder setWarmUpCode(String warmUpCode) {
+            this.warmUpCode = warmUpCode;
+            return this;
+        }
+
+        /**
+         * Configures the maximum number of idle sub interpreters kept for reuse, which is 0 by
+         * default.
+         *
+         * <p>If it is positive, a {@link ExecType#SUB_INTERPRETER} or {@link
+         * ExecType#SUB_INTERPRETER_OWN_GIL} interpreter isn't finalized when it is closed, but is
+         * kept idle with its global variables restored to the ones it had once it was created.
+         * The next {@link PythonInterpreter} created with an equal config reuses it instead of
+         * creating a sub interpreter, importing the modules and reflecting the Java classes
+         * again. The modules imported by the closed interpreter are kept in {@code sys.modules},
+         * and the objects referred by its initial global variables are not copied, so only the
+         * interpreters of the same job should share a config.
+         */
+        public PythonInterpreterConfigBuilder setMaxIdleInterpreters(int maxIdleInterpreters) {
+            this.maxIdleInterpreters = maxIdleInterpreters;
+            return this;
+        }
+
+        /**
+         * Configures how long an idle sub interpreter is kept for reuse, which is 1 minute by
+         * default. The expired interpreters are finalized by the next thread creating or closing
+         * an interpreter.
+         */
+        public PythonInterpreterConfigBuilder setIdleInterpreterTtl(Duration idleInterpreterTtl) {
+            this.idleInterpreterTtl = idleInterpreterTtl;
+            return this;
+        }
+
         /** Creates the actual {@link PythonInterpreterConfig}. */
         public PythonInterpreterConfig build() {
             return new PythonInterpreterConfig(
@@ -183,7 +320,11 @@ public final class PythonInterpreterConfig {
                     workingDirectory,
                     paths.toArray(new String[0]),
                     pythonExec,
-                    execType);
+                    execType,
+                    conversionPolicy,
+                    warmUpCode,
+                    maxIdleInterpreters,
+                    idleInterpreterTtl);
         }
     }
 
@@ -194,10 +335,60 @@ public final class PythonInterpreterConfig {
         MULTI_THREAD,
 
         /**
-         * Python Sub Interpreter has better performance than multi thread because it can better
-         * overcome the performance impact of GIL, but some Python libraries including CPython
+         * Python Sub Interpreter isolates the modules and the globals of every interpreter, but it
+         * shares the GIL with the other interpreters, and some Python libraries including CPython
          * extensions may not support sub interpreter.
          */
-        SUB_INTERPRETER
+        SUB_INTERPRETER,
+
+        /**
+         * Python Sub Interpreter having its own GIL, so that the interpreters run Python code in
+         * parallel. It requires Python 3.12 or later, and only the CPython extensions supporting
+         * the per-interpreter GIL can be imported. Java objects are wrapped into the generic
+         * {@code PyJObject} type rather than the Python types of their Java classes.
+         */
+        SUB_INTERPRETER_OWN_GIL,
+
+        /**
+         * Python threads of the Main Interpreter running without the GIL, so that they run Python
+         * code in parallel. It requires a free-threaded build of Python 3.13 or later, and fails
+         * if the GIL is enabled, e.g. by importing a CPython extension not supporting the
+         * free-threaded build.
+         */
+        FREE_THREADED,
+
+        /**
+         * Python code runs in local worker processes of a {@link ProcessPythonInterpreter}, each of
+         * which has its own GIL. The arguments and the results are copied between the processes,
+         * so only the basic types and the collections of them are supported, and Python code
+         * can't call Java. {@link PythonInterpreter} doesn't support this exec type.
+         */
+        PROCESS
+    }
+
+    /**
+     * The Conversion policy specifies how the Java {@code List}, {@code Map} and {@code
+     * Collection} objects are converted when they are passed to Python.
+     */
+    public enum ConversionPolicy {
+
+        /**
+         * Java collections are wrapped into Python objects which proxy them, so that every access
+         * in Python goes through JNI. This avoids copying collections which are only partially
+         * read in Python.
+         *
+         * <p>Iterating a proxied {@code Collection} in Python fetches up to 64 elements per JNI
+         * call. A modification of the collection during the iteration is therefore only detected
+         * when the next chunk is fetched, and the elements already fetched are still returned.
+         * Iterate over a copy, e.g. {@code list(collection)}, to modify a collection in the loop.
+         */
+        LAZY_PROXY,
+
+        /**
+         * Java collections are copied into Python {@code list} and {@code dict} objects once, so
+         * that Python code scanning them many times pays the JNI cost only once. Modifications in
+         * Python are not visible to the Java collections.
+         */
+        EAGER_COPY
     }
 }
@@ -0,0 +1,406 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core;
+
+import java.util.Arrays;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentLinkedDeque;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Function;
+
+/**
+ * A pool of {@link PythonInterpreter}s, each of which runs on its own worker thread.
+ *
+ * <p>The submitted calls are distributed to the local queues of the workers in turn, and an idle
+ * worker steals the calls queued by the others, so stateless functions can be evaluated on all
+ * the interpreters without each caller owning one. Every interpreter runs the same warm-up script
+ * once it is created, e.g. to import the modules of the functions.
+ *
+ * <p>For example:
+ *
+ * <pre>{@code
+ * try (PythonInterpreterPool pool =
+ *         new PythonInterpreterPool(config, 4, "from udfs import normalize")) {
+ *     CompletableFuture<Object> result = pool.submit("normalize", "Pemja");
+ * }
+ * }</pre>
+ */
+public final class PythonInterpreterPool implements AutoCloseable {
+
+    /** The number of the latest call latencies kept for the percentiles. */
+    private static final int LATENCY_SAMPLES = 1024;
+
+    private final Worker[] workers;
+
+    /** One permit per queued call, so that an idle worker only wakes up if there is work. */
+    private final Semaphore pendingCalls = new Semaphore(0);
+
+    private final AtomicInteger nextWorker = new AtomicInteger();
+
+    private final long[] latencies = new long[LATENCY_SAMPLES];
+
+    private long completedCalls;
+
+    private final long startTime = System.nanoTime();
+
+    private volatile boolean closed;
+
+    /**
+     * Creates a pool of interpreters.
+     *
+     * @param config the config of every interpreter, of {@link
+     *     PythonInterpreterConfig.ExecType#MULTI_THREAD} or {@link
+     *     PythonInterpreterConfig.ExecType#SUB_INTERPRETER}
+     * @param numInterpreters the number of interpreters and worker threads
+     * @param warmUpScript the code executed by every interpreter after it is created, or null
+     */
+    public PythonInterpreterPool(
+            PythonInterpreterConfig config, int numInterpreters, String warmUpScript) {
+        if (numInterpreters <= 0) {
+            throw new IllegalArgumentException(
+                    "The number of interpreters must be positive, but is " + numInterpreters);
+        }
+
+        CountDownLatch started = new CountDownLatch(numInterpreters);
+        workers = new Worker[numInterpreters];
+        for (int i = 0; i < numInterpreters; i++) {
+            workers[i] = new Worker(i, config, warmUpScript, started);
+        }
+        for (Worker worker : workers) {
+            worker.start();
+        }
+
+        try {
+            started.await();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            close();
+            throw new RuntimeException("Interrupted while starting the interpreters.", e);
+        }
+
+        for (Worker worker : workers) {
+            if (worker.error != null) {
+                close();
+                throw new RuntimeException("Failed to start the interpreters.", worker.error);
+            }
+        }
+    }
+
+    /**
+     * Invokes a callable function in one of the interpreters.
+     *
+     * @param name the function name
+     * @param args the variable number of arguments
+     * @return the future of the function result
+     */
+    public CompletableFuture<Object> submit(String name, Object... args) {
+        return submit(interpreter -> interpreter.invoke(name, args));
+    }
+
+    /**
+     * Runs a task with one of the interpreters. The task must not keep the interpreter, which is
+     * only valid in its worker thread.
+     *
+     * @param task the task
+     * @return the future of the task result
+     */
+    public <T> CompletableFuture<T> submit(Function<PythonInterpreter, T> task) {
+        if (closed) {
+            throw new RejectedExecutionException("The interpreter pool has been closed.");
+        }
+
+        Call<T> call = new Call<>(task);
+        int index = Math.floorMod(nextWorker.getAndIncrement(), workers.length);
+        workers[index].queue.addLast(call);
+        pendingCalls.release();
+
+        // the pool may have rejected the queued calls before the call was queued
+        if (closed && workers[index].queue.remove(call)) {
+            call.reject();
+        }
+        return call.future;
+    }
+
+    /** Returns the metrics of the calls and the workers. */
+    public Metrics getMetrics() {
+        long[] samples;
+        long completed;
+        synchronized (latencies) {
+            completed = completedCalls;
+            samples = Arrays.copyOf(latencies, (int) Math.min(completed, LATENCY_SAMPLES));
+        }
+        Arrays.sort(samples);
+
+        int queueDepth = 0;
+        double[] utilization = new double[workers.length];
+        long elapsed = Math.max(1, System.nanoTime() - startTime);
+        for (int i = 0; i < workers.length; i++) {
+            queueDepth += workers[i].queue.size();
+            utilization[i] = Math.min(1.0, (double) workers[i].busyNanos.get() / elapsed);
+        }
+
+        return new Metrics(
+                completed,
+                queueDepth,
+                percentile(samples, 0.5),
+                percentile(samples, 0.9),
+                percentile(samples, 0.99),
+                utilization);
+    }
+
+    /**
+     * Closes all the interpreters after their running calls. The calls still queued are completed
+     * exceptionally with a {@link RejectedExecutionException}.
+     */
+    @Override
+    public void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+
+        // wakes up all the idle workers
+        pendingCalls.release(workers.length);
+        for (Worker worker : workers) {
+            if (worker != null && worker.isAlive()) {
+                try {
+                    worker.join();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    break;
+                }
+            }
+        }
+
+        // the calls submitted concurrently with closing
+        for (Worker worker : workers) {
+            if (worker != null) {
+                worker.failQueuedCalls();
+            }
+        }
+    }
+
+    private void recordLatency(long latency) {
+        synchronized (latencies) {
+            latencies[(int) (completedCalls % LATENCY_SAMPLES)] = latency;
+            completedCalls++;
+        }
+    }
+
+    private static long percentile(long[] sortedSamples, double percentile) {
+        if (sortedSamples.length == 0) {
+            return 0;
+        }
+        int index = (int) Math.ceil(percentile * sortedSamples.length) - 1;
+        return sortedSamples[Math.max(0, Math.min(index, sortedSamples.length - 1))];
+    }
+
+    /** Takes a call from the local queue of the worker, or steals one from the other workers. */
+    private Call<?> takeCall(Worker worker) {
+        Call<?> call = worker.queue.pollFirst();
+        for (int i = 1; call == null && i <= workers.length; i++) {
+            call = workers[(worker.index + i) % workers.length].queue.pollLast();
+        }
+        return call;
+    }
+
+    /** A call submitted to the pool. */
+    private static final class Call<T> {
+        private final Function<PythonInterpreter, T> task;
+
+        private final CompletableFuture<T> future = new CompletableFuture<>();
+
+        private final long submitTime = System.nanoTime();
+
+        private T result;
+
+        private Throwable error;
+
+        private Call(Function<PythonInterpreter, T> task) {
+            this.task = task;
+        }
+
+        /** Runs the task, whose result is only passed to the future by {@link #complete()}. */
+        private void run(PythonInterpreter interpreter) {
+            try {
+                result = task.apply(interpreter);
+            } catch (Throwable t) {
+                error = t;
+            }
+        }
+
+        private void reject() {
+            error = new RejectedExecutionException("The interpreter pool has been closed.");
+            complete();
+        }
+
+        private void complete() {
+            if (error == null) {
+                future.complete(result);
+            } else {
+                future.completeExceptionally(error);
+            }
+        }
+    }
+
+    /** A worker thread owning an interpreter and a local queue of calls. */
+    private final class Worker extends Thread {
+        private final int index;
+
+        private final PythonInterpreterConfig config;
+
+        private final String warmUpScript;
+
+        private final CountDownLatch started;
+
+        private final ConcurrentLinkedDeque<Call<?>> queue = new ConcurrentLinkedDeque<>();
+
+        private final AtomicLong busyNanos = new AtomicLong();
+
+        private volatile Throwable error;
+
+        private Worker(
+                int index,
+                PythonInterpreterConfig config,
+                String warmUpScript,
+                CountDownLatch started) {
+            super("PemJaInterpreterPool-" + index);
+            this.index = index;
+            this.config = config;
+            this.warmUpScript = warmUpScript;
+            this.started = started;
+            setDaemon(true);
+        }
+
+        @Override
+        public void run() {
+            PythonInterpreter interpreter;
+            try {
+                interpreter = new PythonInterpreter(config);
+                if (warmUpScript != null) {
+                    interpreter.exec(warmUpScript);
+                }
+            } catch (Throwable t) {
+                error = t;
+                return;
+            } finally {
+                started.countDown();
+            }
+
+            try {
+                while (true) {
+                    pendingCalls.acquireUninterruptibly();
+                    if (closed) {
+                        break;
+                    }
+
+                    // a permit guarantees a queued call, which may be stolen meanwhile or
+                    // removed by a submit() racing with close()
+                    Call<?> call;
+                    while ((call = takeCall(this)) == null && !closed) {
+                        Thread.yield();
+                    }
+                    if (call == null) {
+                        break;
+                    }
+
+                    long start = System.nanoTime();
+                    call.run(interpreter);
+                    long end = System.nanoTime();
+                    busyNanos.addAndGet(end - start);
+                    // the metrics include the call once its future is completed
+                    recordLatency(end - call.submitTime);
+                    call.complete();
+                }
+            } finally {
+                failQueuedCalls();
+                interpreter.close();
+            }
+        }
+
+        private void failQueuedCalls() {
+            Call<?> call;
+            while ((call = queue.pollFirst()) != null) {
+                call.reject();
+            }
+        }
+    }
+
+    /** A snapshot of the metrics of a {@link PythonInterpreterPool}. */
+    public static final class Metrics {
+        private final long completedCalls;
+
+        private final int queueDepth;
+
+        private final long p50LatencyNanos;
+
+        private final long p90LatencyNanos;
+
+        private final long p99LatencyNanos;
+
+        private final double[] workerUtilization;
+
+        private Metrics(
+                long completedCalls,
+                int queueDepth,
+                long p50LatencyNanos,
+                long p90LatencyNanos,
+                long p99LatencyNanos,
+                double[] workerUtilization) {
+            this.completedCalls = completedCalls;
+            this.queueDepth = queueDepth;
+            this.p50LatencyNanos = p50LatencyNanos;
+            this.p90LatencyNanos = p90LatencyNanos;
+            this.p99LatencyNanos = p99LatencyNanos;
+            this.workerUtilization = workerUtilization;
+        }
+
+        /** Returns the number of the completed calls. */
+        public long getCompletedCalls() {
+            return completedCalls;
+        }
+
+        /** Returns the number of the calls waiting in the queues of the workers. */
+        public int getQueueDepth() {
+            return queueDepth;
+        }
+
+        /** Returns the median latency from submitting to completing of the latest calls. */
+        public long getP50LatencyNanos() {
+            return p50LatencyNanos;
+        }
+
+        /** Returns the 90th percentile latency of the latest calls. */
+        public long getP90LatencyNanos() {
+            return p90LatencyNanos;
+        }
+
+        /** Returns the 99th percentile latency of the latest calls. */
+        public long getP99LatencyNanos() {
+            return p99LatencyNanos;
+        }
+
+        /** Returns the fraction of time every worker has spent running calls since created. */
+        public double[] getWorkerUtilization() {
+            return workerUtilization.clone();
+        }
+    }
+}
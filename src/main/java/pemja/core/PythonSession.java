@@ -0,0 +1,79 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core;
+
+/**
+ * A scope in which the calls of a {@link PythonInterpreter} share one acquisition of its Python
+ * thread state.
+ *
+ * <p>Every call of a {@link PythonInterpreter} acquires the thread state, and so the GIL, and
+ * releases it once it returns. A session acquires it once when it is opened and releases it when
+ * it is closed, so that a sequence of calls doesn't wait for the GIL before every call:
+ *
+ * <pre>{@code
+ * try (PythonSession session = interpreter.session()) {
+ *     interpreter.set("a", 1);
+ *     interpreter.set("b", 2);
+ *     interpreter.exec("c = a + b");
+ *     result = interpreter.get("c", Long.class);
+ * }
+ * }</pre>
+ *
+ * <p>The other threads of the same GIL can't run Python code while the session is open, even
+ * between its calls, so a session should be kept short. The GIL is still released while Python
+ * code calls Java methods. A session belongs to the thread which opened it, and the interpreter
+ * rejects the calls of any other thread until the session is closed.
+ */
+public final class PythonSession implements AutoCloseable {
+
+    private final PythonInterpreter interpreter;
+
+    private final Thread owner;
+
+    private boolean closed;
+
+    PythonSession(PythonInterpreter interpreter, Thread owner) {
+        this.interpreter = interpreter;
+        this.owner = owner;
+    }
+
+    /** Returns the interpreter of this session. */
+    public PythonInterpreter getInterpreter() {
+        return interpreter;
+    }
+
+    /** Releases the Python thread state of the interpreter. */
+    @Override
+    public void close() {
+        checkThread();
+        if (!closed) {
+            closed = true;
+            interpreter.endSession(this);
+        }
+    }
+
+    /** Checks that the current thread is the one which opened this session. */
+    void checkThread() {
+        if (Thread.currentThread() != owner) {
+            throw new IllegalStateException(
+                    String.format(
+                            "The session of the interpreter is owned by thread %s, "
+                                    + "but it is used by thread %s.",
+                            owner.getName(), Thread.currentThread().getName()));
+        }
+    }
+}
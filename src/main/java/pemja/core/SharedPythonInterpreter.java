@@ -0,0 +1,328 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core;
+
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.locks.LockSupport;
+import java.util.function.Function;
+
+/**
+ * An {@link Interpreter} which can be shared by any threads.
+ *
+ * <p>A {@link PythonInterpreter} must only be used by the thread which created it. This
+ * interpreter owns a {@link PythonInterpreter} and a dedicated executor thread running it instead.
+ * The calls of any thread are put into a lock-free queue and run by the executor thread one after
+ * another, so it can be handed across threads, e.g. by actors or by the callbacks of asynchronous
+ * I/O, without creating an interpreter per thread.
+ *
+ * <p>The methods of {@link Interpreter} wait for the results of the calls, spinning a while
+ * before parking the calling thread, and {@link #submit} returns the futures of the results
+ * instead.
+ */
+public final class SharedPythonInterpreter implements Interpreter {
+
+    private static final long serialVersionUID = 1L;
+
+    /** The number of times a caller checks the result of its call before it parks. */
+    private static final int SPIN_TRIES = 1 << 10;
+
+    private final ConcurrentLinkedQueue<Call<?>> queue = new ConcurrentLinkedQueue<>();
+
+    private final Executor executor;
+
+    private volatile boolean closed;
+
+    /**
+     * Creates the interpreter and starts its executor thread.
+     *
+     * @param config the config of the interpreter
+     */
+    public SharedPythonInterpreter(PythonInterpreterConfig config) {
+        CountDownLatch started = new CountDownLatch(1);
+        executor = new Executor(config, started);
+        executor.start();
+
+        try {
+            started.await();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            close();
+            throw new RuntimeException("Interrupted while starting the interpreter.", e);
+        }
+
+        if (executor.error != null) {
+            throw new RuntimeException("Failed to start the interpreter.", executor.error);
+        }
+    }
+
+    @Override
+    public void set(String name, Object value) {
+        call(
+                interpreter -> {
+                    interpreter.set(name, value);
+                    return null;
+                });
+    }
+
+    @Override
+    public Object get(String name) {
+        return call(interpreter -> interpreter.get(name));
+    }
+
+    @Override
+    public <T> T get(String name, Class<T> clazz) {
+        return call(interpreter -> interpreter.get(name, clazz));
+    }
+
+    @Override
+    public Object invoke(String name, Object... args) {
+        return call(interpreter -> interpreter.invoke(name, args));
+    }
+
+    @Override
+    public Object invoke(String name, Map<String, Object> kwargs) {
+        return call(interpreter -> interpreter.invoke(name, kwargs));
+    }
+
+    @Override
+    public Object invoke(String name, Object[] args, Map<String, Object> kwargs) {
+        return call(interpreter -> interpreter.invoke(name, args, kwargs));
+    }
+
+    @Override
+    public Object invokeMethod(String obj, String name, Object... args) {
+        return call(interpreter -> interpreter.invokeMethod(obj, name, args));
+    }
+
+    @Override
+    public void exec(String str) {
+        call(
+                interpreter -> {
+                    interpreter.exec(str);
+                    return null;
+                });
+    }
+
+    /**
+     * Invokes a callable function without waiting for its result.
+     *
+     * @param name the function name
+     * @param args the variable number of arguments
+     * @return the future of the function result
+     */
+    public CompletableFuture<Object> submit(String name, Object... args) {
+        return submit(interpreter -> interpreter.invoke(name, args));
+    }
+
+    /**
+     * Runs a task with the interpreter in the executor thread without waiting for its result. The
+     * task must not keep the interpreter, which is only valid in the executor thread.
+     *
+     * @param task the task
+     * @return the future of the task result
+     */
+    public <T> CompletableFuture<T> submit(Function<PythonInterpreter, T> task) {
+        Call<T> call = new Call<>(task, new CompletableFuture<>());
+        enqueue(call);
+        return call.future;
+    }
+
+    /**
+     * Closes the interpreter after the calls queued before. The calls submitted concurrently with
+     * closing are completed exceptionally with a {@link RejectedExecutionException}.
+     */
+    @Override
+    public void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+
+        LockSupport.unpark(executor);
+        if (Thread.currentThread() != executor) {
+            try {
+                executor.join();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+
+    /** Runs a task in the executor thread and waits for its result. */
+    private <T> T call(Function<PythonInterpreter, T> task) {
+        if (Thread.currentThread() == executor) {
+            // a task calling this interpreter again
+            return task.apply(executor.interpreter);
+        }
+
+        Call<T> call = new Call<>(task, null);
+        enqueue(call);
+        return call.await();
+    }
+
+    private void enqueue(Call<?> call) {
+        if (closed) {
+            throw new RejectedExecutionException("The interpreter has been closed.");
+        }
+        queue.offer(call);
+        if (executor.parked) {
+            LockSupport.unpark(executor);
+        }
+
+        // the executor may have rejected the remaining calls before the call was queued
+        if (closed && queue.remove(call)) {
+            call.reject();
+        }
+    }
+
+    /** A call queued for the executor thread. */
+    private static final class Call<T> {
+        private final Function<PythonInterpreter, T> task;
+
+        private final CompletableFuture<T> future;
+
+        private T result;
+
+        private Throwable error;
+
+        private volatile boolean done;
+
+        private volatile Thread waiter;
+
+        private Call(Function<PythonInterpreter, T> task, CompletableFuture<T> future) {
+            this.task = task;
+            this.future = future;
+        }
+
+        private void run(PythonInterpreter interpreter) {
+            try {
+                result = task.apply(interpreter);
+            } catch (Throwable t) {
+                error = t;
+            }
+            complete();
+        }
+
+        private void reject() {
+            error = new RejectedExecutionException("The interpreter has been closed.");
+            complete();
+        }
+
+        private void complete() {
+            if (future != null) {
+                if (error == null) {
+                    future.complete(result);
+                } else {
+                    future.completeExceptionally(error);
+                }
+            }
+
+            // the result is published by the volatile write
+            done = true;
+            Thread thread = waiter;
+            if (thread != null) {
+                LockSupport.unpark(thread);
+            }
+        }
+
+        private T await() {
+            for (int i = 0; i < SPIN_TRIES && !done; i++) {
+                Thread.yield();
+            }
+
+            if (!done) {
+                waiter = Thread.currentThread();
+                while (!done) {
+                    LockSupport.park(this);
+                }
+            }
+
+            if (error instanceof RuntimeException) {
+                throw (RuntimeException) error;
+            } else if (error instanceof Error) {
+                throw (Error) error;
+            } else if (error != null) {
+                throw new RuntimeException(error);
+            }
+            return result;
+        }
+    }
+
+    /** The thread owning the interpreter, which runs the queued calls. */
+    private final class Executor extends Thread {
+        private final PythonInterpreterConfig config;
+
+        private final CountDownLatch started;
+
+        private PythonInterpreter interpreter;
+
+        private volatile Throwable error;
+
+        /** Whether the executor is parked, or about to park, waiting for calls. */
+        private volatile boolean parked;
+
+        private Executor(PythonInterpreterConfig config, CountDownLatch started) {
+            super("PemJaSharedInterpreter");
+            this.config = config;
+            this.started = started;
+            setDaemon(true);
+        }
+
+        @Override
+        public void run() {
+            try {
+                interpreter = new PythonInterpreter(config);
+            } catch (Throwable t) {
+                error = t;
+                return;
+            } finally {
+                started.countDown();
+            }
+
+            try {
+                while (true) {
+                    Call<?> call = queue.poll();
+                    if (call != null) {
+                        call.run(interpreter);
+                        continue;
+                    }
+                    if (closed) {
+                        break;
+                    }
+
+                    // checks the queue again after announcing the park, so that a call
+                    // enqueued meanwhile either is seen here or unparks the executor
+                    parked = true;
+                    if (queue.isEmpty() && !closed) {
+                        LockSupport.park(this);
+                    }
+                    parked = false;
+                }
+            } finally {
+                Call<?> call;
+                while ((call = queue.poll()) != null) {
+                    call.reject();
+                }
+                interpreter.close();
+            }
+        }
+    }
+}
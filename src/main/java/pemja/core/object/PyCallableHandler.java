@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core.object;
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Constructor;
+import java.lang.reflect.InvocationHandler;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.lang.reflect.Proxy;
+import java.util.HashMap;
+import java.util.Map;
+
+/** Implements a Java functional interface by calling a wrapped Python callable. */
+final class PyCallableHandler implements InvocationHandler {
+
+    private static final Map<Class<?>, Class<?>> BOXED_TYPES = new HashMap<>();
+
+    /** {@code InvocationHandler#invokeDefault} of Java 16+, null in the earlier versions. */
+    private static final MethodHandle INVOKE_DEFAULT = findInvokeDefault();
+
+    static {
+        BOXED_TYPES.put(boolean.class, Boolean.class);
+        BOXED_TYPES.put(byte.class, Byte.class);
+        BOXED_TYPES.put(char.class, Character.class);
+        BOXED_TYPES.put(short.class, Short.class);
+        BOXED_TYPES.put(int.class, Integer.class);
+        BOXED_TYPES.put(long.class, Long.class);
+        BOXED_TYPES.put(float.class, Float.class);
+        BOXED_TYPES.put(double.class, Double.class);
+    }
+
+    private final PyObject callable;
+
+    private final Class<?> iface;
+
+    /** The Java class of the result of the callable, null if the result is discarded. */
+    private final Class<?> returnType;
+
+    private PyCallableHandler(PyObject callable, Class<?> iface, Method method) {
+        this.callable = callable;
+        this.iface = iface;
+        Class<?> type = method.getReturnType();
+        this.returnType = type == void.class ? null : BOXED_TYPES.getOrDefault(type, type);
+    }
+
+    static <T> T newProxy(PyObject callable, Class<T> iface) {
+        Method method = getFunctionalMethod(iface);
+        return iface.cast(
+                Proxy.newProxyInstance(
+                        iface.getClassLoader(),
+                        new Class<?>[] {iface},
+                        new PyCallableHandler(callable, iface, method)));
+    }
+
+    @Override
+    public Object invoke(Object proxy, Method method, Object[] args) throws Throwable {
+        if (method.getDeclaringClass() == Object.class) {
+            switch (method.getName()) {
+                case "equals":
+                    return proxy == args[0];
+                case "hashCode":
+                    return System.identityHashCode(proxy);
+                default:
+                    return iface.getName() + "@" + Integer.toHexString(proxy.hashCode());
+            }
+        }
+
+        if (method.isDefault()) {
+            return invokeDefault(proxy, method, args);
+        }
+
+        return callable.call(returnType, args);
+    }
+
+    /** Invokes the implementation of a default method of the interface on the proxy. */
+    private static Object invokeDefault(Object proxy, Method method, Object[] args)
+            throws Throwable {
+        if (INVOKE_DEFAULT != null) {
+            return INVOKE_DEFAULT.invoke(proxy, method, args);
+        }
+
+        Class<?> declaringClass = method.getDeclaringClass();
+        return privateLookupIn(declaringClass)
+                .unreflectSpecial(method, declaringClass)
+                .bindTo(proxy)
+                .invokeWithArguments(args == null ? new Object[0] : args);
+    }
+
+    private static MethodHandle findInvokeDefault() {
+        try {
+            return MethodHandles.publicLookup()
+                    .findStatic(
+                            InvocationHandler.class,
+                            "invokeDefault",
+                            MethodType.methodType(
+                                    Object.class, Object.class, Method.class, Object[].class));
+        } catch (NoSuchMethodException | IllegalAccessException e) {
+            return null;
+        }
+    }
+
+    /** Gets a lookup with private access to the class, which invokespecial requires. */
+    private static MethodHandles.Lookup privateLookupIn(Class<?> clazz)
+            throws ReflectiveOperationException {
+        try {
+            // Java 9+
+            Method privateLookupIn =
+                    MethodHandles.class.getMethod(
+                            "privateLookupIn", Class.class, MethodHandles.Lookup.class);
+            return (MethodHandles.Lookup)
+                    privateLookupIn.invoke(null, clazz, MethodHandles.lookup());
+        } catch (NoSuchMethodException e) {
+            // Java 8 has no public way to get a lookup in another class
+            Constructor<MethodHandles.Lookup> constructor =
+                    MethodHandles.Lookup.class.getDeclaredConstructor(Class.class, int.class);
+            constructor.setAccessible(true);
+            return constructor.newInstance(clazz, MethodHandles.Lookup.PRIVATE);
+        }
+    }
+
+    /** Gets the single abstract method of a functional interface. */
+    private static Method getFunctionalMethod(Class<?> iface) {
+        if (!iface.isInterface()) {
+            throw new IllegalArgumentException(iface.getName() + " is not an interface.");
+        }
+
+        Method functionalMethod = null;
+        for (Method method : iface.getMethods()) {
+            if (!Modifier.isAbstract(method.getModifiers()) || isObjectMethod(method)) {
+                continue;
+            }
+            if (functionalMethod != null) {
+                throw new IllegalArgumentException(
+                        iface.getName() + " is not a functional interface.");
+            }
+            functionalMethod = method;
+        }
+
+        if (functionalMethod == null) {
+            throw new IllegalArgumentException(iface.getName() + " has no abstract method.");
+        }
+        return functionalMethod;
+    }
+
+    /** Checks whether an abstract method redeclares a public method of Object, e.g. equals. */
+    private static boolean isObjectMethod(Method method) {
+        try {
+            Object.class.getMethod(method.getName(), method.getParameterTypes());
+            return true;
+        } catch (NoSuchMethodException e) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core.object;
+
+import java.util.AbstractMap;
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * A read-only {@link Map} view over a Python {@code dict}, which can be retrieved by {@code
+ * interpreter.get(name, PyDict.class)} instead of copying the whole Python dict into a {@link
+ * HashMap}.
+ *
+ * <p>{@link #size()}, {@link #get(Object)} and {@link #containsKey(Object)} access the live Python
+ * object directly. Bulk operations such as {@link #entrySet()}, {@link #keySet()} and {@link
+ * #values()} work on a snapshot taken with a single native call.
+ */
+public class PyDict extends PyObject implements Map<Object, Object> {
+
+    private final Map<Object, Object> view =
+            new AbstractMap<Object, Object>() {
+                @Override
+                public Set<Entry<Object, Object>> entrySet() {
+                    return PyDict.this.entrySet();
+                }
+
+                @Override
+                public int size() {
+                    return PyDict.this.size();
+                }
+            };
+
+    private PyDict(long tState, long pyDict) {
+        super(tState, pyDict);
+    }
+
+    @Override
+    public int size() {
+        return size(tState, pyobject);
+    }
+
+    @Override
+    public boolean isEmpty() {
+        return size() == 0;
+    }
+
+    @Override
+    public Object get(Object key) {
+        return get(tState, pyobject, key);
+    }
+
+    @Override
+    public boolean containsKey(Object key) {
+        return containsKey(tState, pyobject, key);
+    }
+
+    @Override
+    public boolean containsValue(Object value) {
+        return snapshot().containsValue(value);
+    }
+
+    @Override
+    public Set<Object> keySet() {
+        return snapshot().keySet();
+    }
+
+    @Override
+    public Collection<Object> values() {
+        return snapshot().values();
+    }
+
+    @Override
+    public Set<Entry<Object, Object>> entrySet() {
+        return snapshot().entrySet();
+    }
+
+    @Override
+    public Object put(Object key, Object value) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public Object remove(Object key) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void putAll(Map<?, ?> m) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void clear() {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        return o == this || view.equals(o);
+    }
+
+    @Override
+    public int hashCode() {
+        return view.hashCode();
+    }
+
+    @Override
+    public String toString() {
+        return snapshot().toString();
+    }
+
+    /** Copies all items of the Python dict with a single native call. */
+    private Map<Object, Object> snapshot() {
+        Object[] items = items(tState, pyobject);
+        Map<Object, Object> map = new LinkedHashMap<>(items.length);
+        for (int i = 0; i < items.length; i += 2) {
+            map.put(items[i], items[i + 1]);
+        }
+        return map;
+    }
+
+    private native int size(long tState, long pyDict);
+
+    private native Object get(long tState, long pyDict, Object key);
+
+    private native boolean containsKey(long tState, long pyDict, Object key);
+
+    /** Returns the keys and values of all items in turn. */
+    private native Object[] items(long tState, long pyDict);
+}
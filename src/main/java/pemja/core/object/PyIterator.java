@@ -19,42 +19,88 @@ package pemja.core.object;
 import java.util.Iterator;
 import java.util.NoSuchElementException;
 
-/** The Iterator implementation for Python Iterator. */
+/**
+ * The Iterator implementation for Python Iterator.
+ *
+ * <p>Elements are fetched from Python in chunks of {@link #DEFAULT_CHUNK_SIZE} elements by default,
+ * so that only one native call and GIL acquisition is needed per chunk. The chunk size can be
+ * changed by {@link #setChunkSize(int)}, e.g. set to 1 when the Python iterator has side effects
+ * which must not run ahead of the consumer.
+ */
 public class PyIterator extends PyObject implements Iterator {
 
-    private boolean needFetch = true;
+    /** The default number of elements fetched from Python by one native call. */
+    public static final int DEFAULT_CHUNK_SIZE = 64;
+
+    private static final Object[] EMPTY_CHUNK = new Object[0];
+
+    private int chunkSize = DEFAULT_CHUNK_SIZE;
+
+    /** The elements fetched from Python but not consumed yet. */
+    private Object[] chunk = EMPTY_CHUNK;
+
+    private int position = 0;
 
     private boolean stopIteration = false;
 
-    private Object element;
+    /**
+     * The error raised by the Python iterator after the elements of the last chunk, which is
+     * thrown once they are consumed. It is set by {@link #nextChunk}.
+     */
+    private Throwable pendingError;
 
     private PyIterator(long tsState, long pyIter) {
         super(tsState, pyIter);
     }
 
+    /**
+     * Sets the number of elements fetched from Python by one native call.
+     *
+     * @param chunkSize the number of elements, which must be positive
+     */
+    public void setChunkSize(int chunkSize) {
+        if (chunkSize <= 0) {
+            throw new IllegalArgumentException(
+                    String.format("The chunk size must be positive, but is %d.", chunkSize));
+        }
+        this.chunkSize = chunkSize;
+    }
+
     @Override
     public boolean hasNext() {
+        if (position < chunk.length) {
+            return true;
+        }
+        if (pendingError != null) {
+            Throwable error = pendingError;
+            pendingError = null;
+            throw PyIterator.<RuntimeException>rethrow(error);
+        }
         if (!stopIteration) {
-            try {
-                if (needFetch) {
-                    element = next(tState, pyobject);
-                    needFetch = false;
-                }
-            } catch (NoSuchElementException e) {
-                stopIteration = true;
-            }
+            chunk = nextChunk(tState, pyobject, chunkSize);
+            position = 0;
+            // a partial chunk means the end of the Python iterator has been reached, unless it
+            // is followed by an error
+            stopIteration = chunk.length < chunkSize && pendingError == null;
         }
-        return !stopIteration;
+        return position < chunk.length;
     }
 
     @Override
     public Object next() {
-        if (needFetch) {
-            element = next(tState, pyobject);
+        if (!hasNext()) {
+            throw new NoSuchElementException("StopIteration");
         }
-        needFetch = true;
+        Object element = chunk[position];
+        chunk[position++] = null;
         return element;
     }
 
-    private native Object next(long tsState, long pyIter);
+    /** Throws the {@link pemja.core.PythonException} as the native methods do. */
+    @SuppressWarnings("unchecked")
+    private static <E extends Throwable> E rethrow(Throwable error) throws E {
+        throw (E) error;
+    }
+
+    private native Object[] nextChunk(long tsState, long pyIter, int size);
 }
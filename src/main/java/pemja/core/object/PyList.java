@@ -0,0 +1,196 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.core.object;
+
+import java.util.AbstractList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Iterator;
+import java.util.List;
+import java.util.ListIterator;
+
+/**
+ * A read-only {@link List} view over a Python {@code list}, which can be retrieved by {@code
+ * interpreter.get(name, PyList.class)} instead of copying the whole Python list into an {@link
+ * java.util.ArrayList}.
+ *
+ * <p>{@link #size()}, {@link #get(int)} and {@link #contains(Object)} access the live Python object
+ * directly. Bulk operations such as {@link #toArray()} and {@link #iterator()} work on a snapshot
+ * taken with a single native call.
+ */
+public class PyList extends PyObject implements List<Object> {
+
+    private final List<Object> view =
+            new AbstractList<Object>() {
+                @Override
+                public Object get(int index) {
+                    return PyList.this.get(index);
+                }
+
+                @Override
+                public int size() {
+                    return PyList.this.size();
+                }
+            };
+
+    private PyList(long tState, long pyList) {
+        super(tState, pyList);
+    }
+
+    @Override
+    public int size() {
+        return size(tState, pyobject);
+    }
+
+    @Override
+    public boolean isEmpty() {
+        return size() == 0;
+    }
+
+    @Override
+    public Object get(int index) {
+        return get(tState, pyobject, index);
+    }
+
+    @Override
+    public boolean contains(Object o) {
+        return contains(tState, pyobject, o);
+    }
+
+    @Override
+    public boolean containsAll(Collection<?> c) {
+        for (Object o : c) {
+            if (!contains(o)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    @Override
+    public int indexOf(Object o) {
+        return Arrays.asList(toArray()).indexOf(o);
+    }
+
+    @Override
+    public int lastIndexOf(Object o) {
+        return Arrays.asList(toArray()).lastIndexOf(o);
+    }
+
+    @Override
+    public Object[] toArray() {
+        return toArray(tState, pyobject);
+    }
+
+    @Override
+    public <T> T[] toArray(T[] a) {
+        return Arrays.asList(toArray()).toArray(a);
+    }
+
+    @Override
+    public Iterator<Object> iterator() {
+        return listIterator();
+    }
+
+    @Override
+    public ListIterator<Object> listIterator() {
+        return listIterator(0);
+    }
+
+    @Override
+    public ListIterator<Object> listIterator(int index) {
+        return Arrays.asList(toArray()).listIterator(index);
+    }
+
+    @Override
+    public List<Object> subList(int fromIndex, int toIndex) {
+        return view.subList(fromIndex, toIndex);
+    }
+
+    @Override
+    public boolean add(Object o) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void add(int index, Object element) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean addAll(Collection<?> c) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean addAll(int index, Collection<?> c) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public Object set(int index, Object element) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean remove(Object o) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public Object remove(int index) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean removeAll(Collection<?> c) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean retainAll(Collection<?> c) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void clear() {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        return o == this || view.equals(o);
+    }
+
+    @Override
+    public int hashCode() {
+        return view.hashCode();
+    }
+
+    @Override
+    public String toString() {
+        return Arrays.toString(toArray());
+    }
+
+    private native int size(long tState, long pyList);
+
+    private native Object get(long tState, long pyList, int index);
+
+    private native boolean contains(long tState, long pyList, Object o);
+
+    private native Object[] toArray(long tState, long pyList);
+}
@@ -48,6 +48,54 @@ public class PyObject implements AutoCloseable {
         }
     }
 
+    /**
+     * Calls the wrapped Python callable with the given arguments.
+     *
+     * @param args the variable number of arguments
+     * @return the result of the call
+     */
+    public Object call(Object... args) {
+        return call(Object.class, args);
+    }
+
+    /**
+     * Returns a Java object implementing the functional interface, e.g. {@link
+     * java.util.function.Function}, whose abstract method calls the wrapped Python callable
+     * directly. The default methods of the interface run their Java implementations.
+     *
+     * <p>The returned object is only valid while this {@link PyObject} isn't closed, and must be
+     * called in the thread of the interpreter which created this {@link PyObject}.
+     *
+     * @param iface the functional interface
+     * @return the implementation of the functional interface
+     */
+    public <T> T asInterface(Class<T> iface) {
+        return PyCallableHandler.newProxy(this, iface);
+    }
+
+    /** Calls the wrapped Python callable and converts the result to the given Java class. */
+    Object call(Class<?> returnType, Object[] args) {
+        return call(tState, pyobject, args, returnType);
+    }
+
+    /**
+     * Exports the wrapped {@code pyarrow.RecordBatch} through the <a
+     * href="https://arrow.apache.org/docs/format/CDataInterface.html">Arrow C Data Interface</a>
+     * into the {@code ArrowArray} and {@code ArrowSchema} at the given addresses, e.g. the empty
+     * structs allocated by {@code ArrowArray.allocateNew} of Arrow Java.
+     *
+     * <p>No data is copied. The importer takes over the ownership of both structs and is
+     * responsible for invoking their release callbacks, e.g. {@code
+     * Data.importVectorSchemaRoot} of Arrow Java.
+     *
+     * @param arrayAddress the memory address of the {@code ArrowArray}
+     * @param schemaAddress the memory address of the {@code ArrowSchema}
+     */
+    public void exportRecordBatch(long arrayAddress, long schemaAddress) {
+        invokeMethod(
+                tState, pyobject, "_export_to_c", new Object[] {arrayAddress, schemaAddress});
+    }
+
     @Override
     public void close() throws Exception {
         decRef(tState, pyobject);
@@ -64,4 +112,6 @@ public class PyObject implements AutoCloseable {
     private native Object invokeMethodOneArg(long tState, long pyobject, String name, Object arg);
 
     private native Object invokeMethod(long tState, long pyobject, String name, Object[] args);
+
+    private native Object call(long tState, long pyobject, Object[] args, Class<?> returnType);
 }
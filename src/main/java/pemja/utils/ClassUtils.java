@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.utils;
+
+import pemja.core.NoGilRelease;
+
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/** A util Class to resolve the members of Java Classes by name from Python. */
+public final class ClassUtils {
+
+    private static final Method[] NO_METHODS = new Method[0];
+
+    /** The public methods of every class indexed by method name. */
+    private static final ClassValue<Map<String, Method[]>> METHODS_BY_NAME =
+            new ClassValue<Map<String, Method[]>>() {
+                @Override
+                protected Map<String, Method[]> computeValue(Class<?> type) {
+                    Map<String, List<Method>> methods = new HashMap<>();
+                    for (Method method : type.getMethods()) {
+                        methods.computeIfAbsent(method.getName(), k -> new ArrayList<>())
+                                .add(method);
+                    }
+                    Map<String, Method[]> index = new HashMap<>(methods.size() * 2);
+                    for (Map.Entry<String, List<Method>> entry : methods.entrySet()) {
+                        index.put(entry.getKey(), entry.getValue().toArray(NO_METHODS));
+                    }
+                    return index;
+                }
+            };
+
+    private ClassUtils() {}
+
+    /**
+     * Finds the class with the given fully-qualified name. The context class loader of the current
+     * thread is tried first so that the application classes can be resolved from any thread.
+     *
+     * @param name the fully-qualified class name, e.g. java.util.ArrayList
+     * @return the class.
+     * @throws ClassNotFoundException if there is no such class.
+     */
+    public static Class<?> findClass(String name) throws ClassNotFoundException {
+        ClassLoader loader = Thread.currentThread().getContextClassLoader();
+        if (loader != null) {
+            try {
+                return Class.forName(name, true, loader);
+            } catch (ClassNotFoundException e) {
+                // fall back to the class loader of pemja
+            }
+        }
+        return Class.forName(name, true, ClassUtils.class.getClassLoader());
+    }
+
+    /**
+     * Gets the public methods of the class with the given name, including the inherited ones.
+     *
+     * @param clazz the Java Class
+     * @param name the method name
+     * @return the methods, or an empty array if there is no such method.
+     */
+    public static Method[] getMethods(Class<?> clazz, String name) {
+        return METHODS_BY_NAME.get(clazz).getOrDefault(name, NO_METHODS);
+    }
+
+    /**
+     * Gets the public field of the class with the given name, including the inherited ones.
+     *
+     * @param clazz the Java Class
+     * @param name the field name
+     * @return the field, or null if there is no such field.
+     */
+    public static Field getField(Class<?> clazz, String name) {
+        try {
+            return clazz.getField(name);
+        } catch (NoSuchFieldException e) {
+            return null;
+        }
+    }
+
+    /**
+     * Checks whether the method is called from Python without releasing the GIL.
+     *
+     * @param method the Java method
+     * @return true if the method or its declaring class is annotated with {@link NoGilRelease}.
+     */
+    public static boolean isNoGilRelease(Method method) {
+        return method.isAnnotationPresent(NoGilRelease.class)
+                || method.getDeclaringClass().isAnnotationPresent(NoGilRelease.class);
+    }
+}
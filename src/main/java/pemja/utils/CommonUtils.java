@@ -38,6 +38,8 @@ public class CommonUtils {
     private static final String GET_PEMJA_MODULE_PATH_SCRIPT =
             "import pemja;" + "import os;" + "print(os.path.dirname(pemja.__file__))";
 
+    private boolean utilsLoaded;
+
     private CommonUtils() {}
 
     public void loadPython(String pythonExec) {
@@ -49,6 +51,21 @@ public class CommonUtils {
         loadPythonLibrary(pythonExec, "pemja_core");
     }
 
+    /**
+     * Loads the native utils of PemJa without CPython, e.g. for the interpreters running Python in
+     * other processes.
+     */
+    public synchronized void loadUtils(String pythonExec) {
+        if (!utilsLoaded) {
+            if (isWindowsOs()) {
+                // the extension is linked with the CPython library on Windows
+                loadLibrary(getPythonLibrary(pythonExec), "libpython");
+            }
+            loadPythonLibrary(pythonExec, "pemja_utils");
+            utilsLoaded = true;
+        }
+    }
+
     public String getPemJaModulePath(String pythonExec) {
         if (pythonExec == null) {
             // run in source code
@@ -198,7 +215,8 @@ public class CommonUtils {
         return os.startsWith("Windows");
     }
 
-    private String getPythonCommand() {
+    /** Returns the command of the default Python interpreter. */
+    public String getPythonCommand() {
         return isWindowsOs() ? "python" : "python3";
     }
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.utils;
+
+import java.nio.ByteBuffer;
+
+/**
+ * The positions shared with other processes in a direct {@link ByteBuffer}, which are waited for
+ * with futexes on Linux. Every position is 8 bytes at an aligned offset, followed by the 4 bytes
+ * flag of its waiter. The other systems poll the positions with short sleeps instead.
+ *
+ * <p>The native library is loaded by {@link CommonUtils#loadUtils}.
+ */
+public final class Futex {
+
+    private Futex() {}
+
+    /** Loads the position at the offset of the buffer. */
+    public static native long load(ByteBuffer buffer, int offset);
+
+    /** Stores the position at the offset of the buffer and wakes up its waiter. */
+    public static native void store(ByteBuffer buffer, int offset, long value);
+
+    /**
+     * Waits until the position at the offset of the buffer differs from the expected one, or the
+     * timeout expires.
+     *
+     * @return the current position
+     */
+    public static native long await(
+            ByteBuffer buffer, int offset, long expected, long timeoutNanos);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2022 Alibaba Group Holding Limited.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package pemja.utils;
+
+import java.util.Iterator;
+
+/** A util Class to iterate Java Iterators in chunks from Python. */
+public final class IteratorUtils {
+
+    private static final Object[] EMPTY_CHUNK = new Object[0];
+
+    private IteratorUtils() {}
+
+    /**
+     * Fetches up to {@code size} elements from the iterator, so that iterating a Java Iterator in
+     * Python only crosses JNI once per chunk.
+     *
+     * @param iterator the Java Iterator
+     * @param size the maximum number of elements
+     * @return the fetched elements. Less elements than {@code size} means the end of the iterator
+     *     has been reached.
+     */
+    public static Object[] nextChunk(Iterator<?> iterator, int size) {
+        if (!iterator.hasNext()) {
+            return EMPTY_CHUNK;
+        }
+        Object[] chunk = new Object[size];
+        int length = 0;
+        while (length < size && iterator.hasNext()) {
+            chunk[length++] = iterator.next();
+        }
+        if (length < size) {
+            Object[] result = new Object[length];
+            System.arraycopy(chunk, 0, result, 0, length);
+            return result;
+        }
+        return chunk;
+    }
+}
@@ -18,3 +18,7 @@ try:
     from _pemja import *
 except ImportError:
     pass
+else:
+    from pemja.java_importer import install as install_java_importer
+
+    install_java_importer("java", "javax")
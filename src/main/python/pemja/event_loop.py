@@ -0,0 +1,63 @@
+################################################################################
+#
+#  Copyright 2022 Alibaba Group Holding Limited.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+"""
+The asyncio event loop of a `pemja.core.PythonInterpreter`, which runs the
+coroutines of `PythonInterpreter.invokeAsync` in a thread of its own.
+
+The thread is bound to the JcpThread of the interpreter, so that the results of
+the coroutines are converted to Java objects like the results of `invoke`. The
+Java futures are completed in the thread by `_pemja.complete_future`.
+"""
+
+import asyncio
+import functools
+import threading
+
+import _pemja
+
+
+class EventLoop(object):
+    """An asyncio event loop running in a new thread."""
+
+    def __init__(self, jcp_thread):
+        self._loop = asyncio.new_event_loop()
+        self._thread = threading.Thread(
+            target=_pemja.run_event_loop,
+            args=(self._loop, jcp_thread),
+            name='PemJaEventLoop')
+        self._thread.start()
+
+    def submit(self, coroutine, future):
+        """Runs the coroutine and completes the Java future with its result."""
+        running = asyncio.run_coroutine_threadsafe(coroutine, self._loop)
+        running.add_done_callback(
+            functools.partial(_pemja.complete_future, future))
+
+    def stop(self):
+        """Cancels the running coroutines, whose Java futures are cancelled,
+        and stops the event loop once they are done."""
+        asyncio.run_coroutine_threadsafe(self._shutdown(), self._loop)
+        self._thread.join()
+        self._loop.close()
+
+    async def _shutdown(self):
+        current = asyncio.current_task()
+        tasks = [task for task in asyncio.all_tasks() if task is not current]
+        for task in tasks:
+            task.cancel()
+        await asyncio.gather(*tasks, return_exceptions=True)
+        self._loop.stop()
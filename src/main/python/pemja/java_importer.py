@@ -0,0 +1,81 @@
+################################################################################
+#
+#  Copyright 2022 Alibaba Group Holding Limited.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+import importlib.abc
+import importlib.machinery
+import sys
+import types
+
+
+class JavaPackage(types.ModuleType):
+    """
+    A Java package whose classes are found lazily by their names.
+    """
+
+    def __getattr__(self, name):
+        if name.startswith("__"):
+            raise AttributeError(name)
+
+        from _pemja import findClass
+
+        try:
+            clazz = findClass("%s.%s" % (self.__name__, name))
+        except RuntimeError:
+            raise AttributeError(
+                "Java package '%s' has no class '%s'" % (self.__name__, name)
+            ) from None
+        setattr(self, name, clazz)
+        return clazz
+
+
+class JavaImporter(importlib.abc.MetaPathFinder, importlib.abc.Loader):
+    """
+    Imports Java packages as Python modules, e.g. `from java.util import ArrayList`.
+    """
+
+    def __init__(self):
+        self._packages = set()
+
+    def add_packages(self, *packages):
+        self._packages.update(packages)
+
+    def find_spec(self, fullname, path=None, target=None):
+        names = fullname.split(".")
+        # Java package names are lower-case, an unknown class must not become a package
+        if names[0] not in self._packages or names[-1][:1].isupper():
+            return None
+        return importlib.machinery.ModuleSpec(fullname, self, is_package=True)
+
+    def create_module(self, spec):
+        return JavaPackage(spec.name)
+
+    def exec_module(self, module):
+        pass
+
+
+def install(*packages):
+    """
+    Makes the Java classes under the given top-level packages importable. The importer
+    is consulted after the Python ones, so Python packages of the same names still win.
+    """
+    for finder in sys.meta_path:
+        if isinstance(finder, JavaImporter):
+            break
+    else:
+        finder = JavaImporter()
+        sys.meta_path.append(finder)
+    finder.add_packages(*packages)
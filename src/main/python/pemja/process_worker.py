@@ -0,0 +1,342 @@
+################################################################################
+#
+#  Copyright 2022 Alibaba Group Holding Limited.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+"""
+The worker process of a `pemja.core.ProcessPythonInterpreter`.
+
+The worker is run as a script with the path of a shared memory file holding two
+ring buffers, the requests written by Java and the responses written by the
+worker. A ring buffer starts with the position written by its producer and the
+one written by its consumer, each in its own cache line and followed by the
+flag of its waiter, and then the data. Every message is the 4 bytes length of
+its payload followed by the payload.
+
+The positions are stored and waited for by the futex functions of the native
+utils of pemja, which wake up the consumer once a message is written. The
+worker exits once its stdin is closed. The stdin of the Python code is
+redirected from the null device, and its stdout to stderr.
+"""
+
+import builtins
+import ctypes
+import decimal
+import glob
+import mmap
+import os
+import struct
+import sys
+import threading
+import traceback
+
+_U32 = struct.Struct('<I')
+_I64 = struct.Struct('<q')
+_F64 = struct.Struct('<d')
+
+_TAIL_OFFSET = 0
+_HEAD_OFFSET = 64
+_DATA_OFFSET = 128
+
+# the time waiting for a request before checking whether the worker is closed
+_WAIT_NANOS = 100 * 1000 * 1000
+
+# the tags of the encoded values, which must be kept in sync with the Java side
+_NONE = 0
+_FALSE = 1
+_TRUE = 2
+_INT = 3
+_BIG_INT = 4
+_FLOAT = 5
+_STR = 6
+_BYTES = 7
+_LIST = 8
+_TUPLE = 9
+_DICT = 10
+_DECIMAL = 11
+
+# the operations of the requests
+_SET = 0
+_GET = 1
+_INVOKE = 2
+_INVOKE_METHOD = 3
+_EXEC = 4
+
+
+def _load_futex():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    paths = (glob.glob(os.path.join(directory, 'pemja_utils.*.so')) +
+             glob.glob(os.path.join(directory, 'pemja_utils.*.pyd')))
+    if not paths:
+        raise ImportError("The native utils of pemja are not found in %s."
+                          % directory)
+    futex = ctypes.CDLL(paths[0])
+    futex.pemja_futex_load.restype = ctypes.c_int64
+    futex.pemja_futex_load.argtypes = (ctypes.c_void_p,)
+    futex.pemja_futex_store.restype = None
+    futex.pemja_futex_store.argtypes = (ctypes.c_void_p, ctypes.c_int64)
+    futex.pemja_futex_wait.restype = ctypes.c_int64
+    futex.pemja_futex_wait.argtypes = (
+        ctypes.c_void_p, ctypes.c_int64, ctypes.c_int64)
+    return futex
+
+
+class _Ring(object):
+    """A single producer and single consumer ring buffer in shared memory."""
+
+    def __init__(self, futex, buffer, address, offset, capacity):
+        self._futex = futex
+        self._buffer = buffer
+        self._offset = offset
+        self._capacity = capacity
+        self._tail = address + offset + _TAIL_OFFSET
+        self._head = address + offset + _HEAD_OFFSET
+
+    def wait(self):
+        """Waits for a message. Returns False if the timeout expires."""
+        head = self._futex.pemja_futex_load(self._head)
+        return self._futex.pemja_futex_wait(
+            self._tail, head, _WAIT_NANOS) != head
+
+    def wake(self):
+        """Wakes up the consumer without writing any message."""
+        self._futex.pemja_futex_store(
+            self._tail, self._futex.pemja_futex_load(self._tail))
+
+    def read(self):
+        head = self._futex.pemja_futex_load(self._head)
+        length = _U32.unpack(self._read(head, 4))[0]
+        data = self._read(head + 4, length)
+        self._futex.pemja_futex_store(self._head, head + 4 + length)
+        return data
+
+    def write(self, data):
+        tail = self._futex.pemja_futex_load(self._tail)
+        head = self._futex.pemja_futex_load(self._head)
+        if 4 + len(data) > self._capacity - (tail - head):
+            raise BufferError(
+                "The message of %d bytes exceeds the ring buffer of %d bytes."
+                % (len(data), self._capacity))
+        self._write(tail, _U32.pack(len(data)))
+        self._write(tail + 4, data)
+        # publishes the message and wakes up Java
+        self._futex.pemja_futex_store(self._tail, tail + 4 + len(data))
+
+    def _read(self, position, length):
+        start = self._offset + _DATA_OFFSET
+        index = position % self._capacity
+        first = min(length, self._capacity - index)
+        data = self._buffer[start + index:start + index + first]
+        if first < length:
+            data += self._buffer[start:start + length - first]
+        return data
+
+    def _write(self, position, data):
+        start = self._offset + _DATA_OFFSET
+        index = position % self._capacity
+        first = min(len(data), self._capacity - index)
+        self._buffer[start + index:start + index + first] = data[:first]
+        if first < len(data):
+            self._buffer[start:start + len(data) - first] = data[first:]
+
+
+def _encode(value, out):
+    if value is None:
+        out.append(_NONE)
+    elif value is False:
+        out.append(_FALSE)
+    elif value is True:
+        out.append(_TRUE)
+    elif isinstance(value, int):
+        if -(1 << 63) <= value < (1 << 63):
+            out.append(_INT)
+            out += _I64.pack(value)
+        else:
+            out.append(_BIG_INT)
+            _encode_str(str(value), out)
+    elif isinstance(value, float):
+        out.append(_FLOAT)
+        out += _F64.pack(value)
+    elif isinstance(value, str):
+        out.append(_STR)
+        _encode_str(value, out)
+    elif isinstance(value, (bytes, bytearray)):
+        out.append(_BYTES)
+        out += _U32.pack(len(value))
+        out += value
+    elif isinstance(value, (list, tuple)):
+        out.append(_LIST if isinstance(value, list) else _TUPLE)
+        out += _U32.pack(len(value))
+        for item in value:
+            _encode(item, out)
+    elif isinstance(value, dict):
+        out.append(_DICT)
+        out += _U32.pack(len(value))
+        for k, v in value.items():
+            _encode(k, out)
+            _encode(v, out)
+    elif isinstance(value, decimal.Decimal):
+        out.append(_DECIMAL)
+        _encode_str(str(value), out)
+    else:
+        raise TypeError(
+            "The object of type %s can't be returned from a worker process."
+            % type(value).__name__)
+
+
+def _encode_str(value, out):
+    data = value.encode('utf-8')
+    out += _U32.pack(len(data))
+    out += data
+
+
+def _decode(data, offset):
+    tag = data[offset]
+    offset += 1
+    if tag == _NONE:
+        return None, offset
+    elif tag == _FALSE:
+        return False, offset
+    elif tag == _TRUE:
+        return True, offset
+    elif tag == _INT:
+        return _I64.unpack_from(data, offset)[0], offset + 8
+    elif tag == _FLOAT:
+        return _F64.unpack_from(data, offset)[0], offset + 8
+    elif tag in (_STR, _BIG_INT, _DECIMAL):
+        value, offset = _decode_str(data, offset)
+        if tag == _BIG_INT:
+            value = int(value)
+        elif tag == _DECIMAL:
+            value = decimal.Decimal(value)
+        return value, offset
+    elif tag == _BYTES:
+        length = _U32.unpack_from(data, offset)[0]
+        offset += 4
+        return bytes(data[offset:offset + length]), offset + length
+    elif tag in (_LIST, _TUPLE):
+        length = _U32.unpack_from(data, offset)[0]
+        offset += 4
+        items = []
+        for _ in range(length):
+            item, offset = _decode(data, offset)
+            items.append(item)
+        return (items if tag == _LIST else tuple(items)), offset
+    elif tag == _DICT:
+        length = _U32.unpack_from(data, offset)[0]
+        offset += 4
+        value = {}
+        for _ in range(length):
+            k, offset = _decode(data, offset)
+            v, offset = _decode(data, offset)
+            value[k] = v
+        return value, offset
+    raise ValueError("Unknown tag %d of the encoded value." % tag)
+
+
+def _decode_str(data, offset):
+    length = _U32.unpack_from(data, offset)[0]
+    offset += 4
+    return str(data[offset:offset + length], 'utf-8'), offset + length
+
+
+def _load(namespace, name):
+    if name in namespace:
+        return namespace[name]
+    # the function of a module imported in the namespace, e.g. `os.getpid`
+    module_name, dot, function_name = name.partition('.')
+    if dot and module_name in namespace:
+        return getattr(namespace[module_name], function_name)
+    raise NameError("name '%s' is not defined" % name)
+
+
+def _call(namespace, request):
+    op = request[0]
+    if op == _SET:
+        namespace[request[1]] = request[2]
+    elif op == _GET:
+        return namespace[request[1]]
+    elif op == _INVOKE:
+        return _load(namespace, request[1])(*request[2], **(request[3] or {}))
+    elif op == _INVOKE_METHOD:
+        return getattr(_load(namespace, request[1]), request[2])(*request[3])
+    elif op == _EXEC:
+        exec(request[1], namespace)
+    else:
+        raise ValueError("Unknown operation %d of the request." % op)
+
+
+def _response(namespace, request):
+    out = bytearray()
+    try:
+        _encode((True, _call(namespace, request)), out)
+    except BaseException as e:
+        out = bytearray()
+        message = "%s: %s" % (type(e).__name__, e)
+        _encode((False, message, traceback.format_exc()), out)
+    return out
+
+
+def main():
+    # the worker is run as a script, so its directory is not a search path
+    if sys.path and os.path.abspath(sys.path[0]) == os.path.dirname(
+            os.path.abspath(__file__)):
+        del sys.path[0]
+
+    path = sys.argv[1]
+    capacity = int(sys.argv[2])
+    ring_size = _DATA_OFFSET + capacity
+
+    futex = _load_futex()
+    with open(path, 'r+b') as f:
+        buffer = mmap.mmap(f.fileno(), 2 * ring_size)
+    address = ctypes.addressof(ctypes.c_char.from_buffer(buffer))
+    requests = _Ring(futex, buffer, address, 0, capacity)
+    responses = _Ring(futex, buffer, address, ring_size, capacity)
+
+    # keeps the original stdin to find out when the worker is closed
+    stdin = os.dup(0)
+    null = os.open(os.devnull, os.O_RDONLY)
+    os.dup2(null, 0)
+    os.close(null)
+    os.dup2(2, 1)
+
+    closed = threading.Event()
+
+    def wait_closed():
+        while os.read(stdin, 1):
+            pass
+        closed.set()
+        requests.wake()
+
+    threading.Thread(target=wait_closed, daemon=True).start()
+
+    namespace = {'__name__': '__main__', '__builtins__': builtins}
+
+    while not closed.is_set():
+        if not requests.wait():
+            continue
+        request, _ = _decode(memoryview(requests.read()), 0)
+        response = _response(namespace, request)
+        sys.stdout.flush()
+        try:
+            responses.write(response)
+        except BufferError as e:
+            response = bytearray()
+            _encode((False, "BufferError: %s" % e, ''), response)
+            responses.write(response)
+
+
+if __name__ == '__main__':
+    main()
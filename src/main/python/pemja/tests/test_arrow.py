@@ -0,0 +1,99 @@
+################################################################################
+#
+#  Copyright 2022 Alibaba Group Holding Limited.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+import ctypes
+import importlib.util
+
+
+class ArrowSchema(ctypes.Structure):
+    pass
+
+
+ArrowSchema._fields_ = [
+    ("format", ctypes.c_char_p),
+    ("name", ctypes.c_char_p),
+    ("metadata", ctypes.c_char_p),
+    ("flags", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("children", ctypes.POINTER(ctypes.POINTER(ArrowSchema))),
+    ("dictionary", ctypes.POINTER(ArrowSchema)),
+    ("release", ctypes.c_void_p),
+    ("private_data", ctypes.c_void_p),
+]
+
+
+class ArrowArray(ctypes.Structure):
+    pass
+
+
+ArrowArray._fields_ = [
+    ("length", ctypes.c_int64),
+    ("null_count", ctypes.c_int64),
+    ("offset", ctypes.c_int64),
+    ("n_buffers", ctypes.c_int64),
+    ("n_children", ctypes.c_int64),
+    ("buffers", ctypes.POINTER(ctypes.c_void_p)),
+    ("children", ctypes.POINTER(ctypes.POINTER(ArrowArray))),
+    ("dictionary", ctypes.POINTER(ArrowArray)),
+    ("release", ctypes.c_void_p),
+    ("private_data", ctypes.c_void_p),
+]
+
+# keeps the allocated C Data Interface structs alive during the test
+_c_structs = []
+
+
+def has_pyarrow():
+    return importlib.util.find_spec("pyarrow") is not None
+
+
+def new_c_structs():
+    array = ArrowArray()
+    schema = ArrowSchema()
+    _c_structs.append((array, schema))
+    return ctypes.addressof(array), ctypes.addressof(schema)
+
+
+def export_record_batch(array_address, schema_address):
+    import pyarrow as pa
+
+    batch = pa.record_batch(
+        [pa.array([1, 2, 3]), pa.array(["a", "b", None])], names=["a", "b"]
+    )
+    batch._export_to_c(array_address, schema_address)
+
+
+def is_released(array_address, schema_address):
+    array = ArrowArray.from_address(array_address)
+    schema = ArrowSchema.from_address(schema_address)
+    return not array.release and not schema.release
+
+
+def test_record_batch(batch):
+    import pyarrow as pa
+
+    assert isinstance(batch, pa.RecordBatch)
+    assert batch.num_rows == 3
+    return pa.record_batch(
+        [pa.array([v * 2 for v in batch.column(0).to_pylist()]), batch.column(1)],
+        names=batch.schema.names,
+    )
+
+
+def read_record_batch(array_address, schema_address):
+    import pyarrow as pa
+
+    return pa.RecordBatch._import_from_c(array_address, schema_address).to_pydict()
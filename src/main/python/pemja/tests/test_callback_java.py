@@ -32,6 +32,26 @@ def test_callback_java_basic():
     return sb.toString()
 
 
+def test_import_java_class():
+    from pemja import findClass
+    from java.lang import StringBuilder
+    from java.util import ArrayList
+
+    assert ArrayList is findClass("java.util.ArrayList")
+    assert StringBuilder is findClass("java.lang.StringBuilder")
+
+    try:
+        from java.util import NoSuchClass
+    except ImportError:
+        pass
+    else:
+        raise AssertionError("java.util.NoSuchClass should not be importable")
+
+    sb = StringBuilder()
+    sb.append("pemja")
+    return sb.toString()
+
+
 def test_callback_with_all_types(self):
     # bool
     assert_equals(self.testBoolean(True), "testBoolean_boolean")
@@ -73,10 +93,46 @@ def test_callback_with_all_types(self):
     assert_equals(self.testArray(("pemja", "java")), "testArray")
     assert_equals(self.testIntArray((1, 2)), "testIntArray")
 
+    # many args
+    assert_equals(self.testManyArgs(1, 2, 3, 4, 5, 6, 7, 8, 9), 45)
+
+    # no gil release
+    assert_equals(self.testNoGilRelease(1, 2), 3)
+
     # field
     assert_equals(self.NAME, "TestObject")
 
 
+def test_no_gil_release(self):
+    import sys
+    import threading
+    import time
+
+    if not getattr(sys, "_is_gil_enabled", lambda: True)():
+        return
+
+    ticks = [time.monotonic()]
+    stopped = threading.Event()
+
+    def tick():
+        while not stopped.is_set():
+            ticks.append(time.monotonic())
+
+    thread = threading.Thread(target=tick)
+    thread.start()
+    try:
+        while len(ticks) < 2:
+            time.sleep(0.001)
+        # the ticking thread can't run while the GIL is held by the Java call
+        self.testNoGilReleaseSleep(200)
+    finally:
+        stopped.set()
+        thread.join()
+
+    gap = max(b - a for a, b in zip(ticks, ticks[1:]))
+    assert gap >= 0.19, "the other thread paused for {0}s only".format(gap)
+
+
 def test_java_call_python(self, interpreter):
     assert_equals(self.testJavaCallPython(interpreter), "testJavaCallPython")
 
@@ -44,6 +44,78 @@ def test_call_java_object(o):
     return o
 
 
+def test_call_method(o, name, *args):
+    return getattr(o, name)(*args)
+
+
+def test_resolve_members(point):
+    assert point.x == 1
+    point.x = 3
+    assert point.getX() == 3.0
+    assert not hasattr(point, "no_such_member")
+    return point
+
+
+def test_batched_fields(point):
+    from pemja import FieldReader, FieldWriter, fields, findClass
+
+    Point = findClass("java.awt.Point")
+    reader = FieldReader(Point, ("x", "y"))
+    writer = FieldWriter(Point, ["y", "x"])
+
+    assert fields(point, ("x", "y")) == (1, 2)
+    assert reader(point) == (1, 2)
+    writer(point, (5, 4))
+    assert reader(point) == (4, 5)
+
+    try:
+        FieldReader(Point, ("x", "getX"))
+    except AttributeError:
+        pass
+    else:
+        raise AssertionError("getX is not a field of java.awt.Point")
+    return point
+
+
+def test_call_overloads(builder, items):
+    for _ in range(2):
+        builder.append("a").append(1).append(2.5).append(True).append(items)
+    return builder.toString()
+
+
+def test_map_call(builder):
+    from pemja import findClass, map_call, starmap_call
+
+    Integer = findClass("java.lang.Integer")
+    assert map_call(Integer.toHexString, range(100)) == [
+        hex(i)[2:] for i in range(100)
+    ]
+    assert starmap_call(Integer.toString, [(255, 16), (8, 2)]) == ["ff", "1000"]
+    assert map_call(Integer.toHexString, []) == []
+
+    map_call(builder.append, ["a", 1, 2.5, True, "b"])
+    return builder.toString()
+
+
+def test_class_type(builder):
+    cls = type(builder)
+    assert cls.__module__ == "java.lang"
+    assert type(builder.append("pemja")) is cls
+    assert builder.length() == 5
+    assert cls.length(builder) == 5
+    return cls.__name__
+
+
+def test_lazy_members(joiner):
+    cls = type(joiner)
+    # the members are installed into the type on the first access
+    assert "add" not in vars(cls)
+    joiner.add("pemja")
+    assert "add" in vars(cls)
+    assert not hasattr(joiner, "missing")
+    return joiner.toString()
+
+
 def test_map(o):
     assert list(o.keys()) == ["python", "java", "pemja"]
     for i, (k, v) in enumerate(o.items()):
@@ -65,3 +137,25 @@ def test_list(o):
     assert o[1] == "java"
     assert o[2] == "pemja"
     return o
+
+
+def test_type_name(o):
+    return type(o).__name__
+
+
+def test_iterate_collection(collection):
+    iterator = iter(collection)
+    assert type(iterator).__name__ == "PyJBufferedIterator"
+    return sum(iterator)
+
+
+def test_modify_while_iterating(collection):
+    seen = []
+    try:
+        for element in collection:
+            if not seen:
+                collection.add(element)
+            seen.append(element)
+    except RuntimeError as e:
+        return str(e)
+    return len(seen)
@@ -19,30 +19,55 @@ package pemja.core;
 import org.junit.After;
 import org.junit.Before;
 import org.junit.Test;
+import pemja.core.object.PyDict;
 import pemja.core.object.PyIterator;
+import pemja.core.object.PyList;
 import pemja.core.object.PyObject;
 
+import java.awt.Point;
 import java.io.File;
 import java.io.FileNotFoundException;
 import java.io.IOException;
 import java.math.BigDecimal;
 import java.math.BigInteger;
+import java.net.URL;
+import java.net.URLClassLoader;
 import java.nio.file.Files;
 import java.sql.Date;
 import java.sql.Time;
 import java.sql.Timestamp;
+import java.time.Duration;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collection;
 import java.util.HashMap;
+import java.util.HashSet;
 import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
+import java.util.StringJoiner;
 import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicReference;
+import java.util.function.Function;
+import java.util.function.IntPredicate;
+import java.util.function.Supplier;
+import java.util.stream.Collectors;
+import java.util.stream.IntStream;
 
 import static org.junit.Assert.assertArrayEquals;
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import static org.junit.Assume.assumeTrue;
 
 /** Tests for {@link PythonInterpreter}. */
 public class PythonInterpreterTest {
@@ -361,6 +386,53 @@ public class PythonInterpreterTest {
         }
     }
 
+    @Test
+    public void testPyIteratorChunk() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_call");
+            for (int chunkSize : new int[] {1, 3, 7, PyIterator.DEFAULT_CHUNK_SIZE}) {
+                // the generator yields 2 extra elements "haha" and None
+                for (int num : new int[] {0, 1, 5, 128, 200}) {
+                    try (PyIterator iterator =
+                            (PyIterator)
+                                    interpreter.invoke("test_call.test_return_generator", num)) {
+                        iterator.setChunkSize(chunkSize);
+                        for (long i = 0; i < num; i++) {
+                            assertTrue(iterator.hasNext());
+                            assertEquals(i, iterator.next());
+                        }
+                        assertEquals("haha", iterator.next());
+                        assertTrue(iterator.hasNext());
+                        assertEquals(null, iterator.next());
+                        assertFalse(iterator.hasNext());
+                        assertFalse(iterator.hasNext());
+                    }
+                }
+            }
+
+            // the elements fetched before an error are consumed before it is thrown
+            interpreter.exec(
+                    "def failing_generator():\n"
+                            + "    yield 1\n"
+                            + "    yield 2\n"
+                            + "    raise ValueError('broken')");
+            try (PyIterator iterator = (PyIterator) interpreter.invoke("failing_generator")) {
+                assertEquals(1L, iterator.next());
+                assertEquals(2L, iterator.next());
+                try {
+                    iterator.hasNext();
+                    fail("The error of the Python iterator should be thrown.");
+                } catch (Exception e) {
+                    assertTrue(e instanceof PythonException);
+                    assertTrue(e.getMessage().contains("broken"));
+                }
+                assertFalse(iterator.hasNext());
+            }
+        }
+    }
+
     @Test
     public void testCallPyJObject() {
         PythonInterpreterConfig config =
@@ -389,6 +461,272 @@ public class PythonInterpreterTest {
         }
     }
 
+    @Test
+    public void testResolveJavaMembersByName() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            assertEquals(
+                    new Point(3, 2),
+                    interpreter.invoke("test_pyjobject.test_resolve_members", new Point(1, 2)));
+        }
+    }
+
+    @Test
+    public void testBatchedJavaFieldAccess() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            assertEquals(
+                    new Point(4, 5),
+                    interpreter.invoke("test_pyjobject.test_batched_fields", new Point(1, 2)));
+        }
+    }
+
+    @Test
+    public void testMapCallJavaMethods() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            assertEquals(
+                    "a12.5trueb",
+                    interpreter.invoke("test_pyjobject.test_map_call", new StringBuilder()));
+        }
+    }
+
+    @Test
+    public void testPythonTypesOfJavaClasses() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            assertEquals(
+                    "StringBuilder",
+                    interpreter.invoke("test_pyjobject.test_class_type", new StringBuilder()));
+            assertEquals(
+                    "TestObject",
+                    interpreter.invoke("test_pyjobject.test_type_name", new TestObject<>())
+                            .toString()
+                            .replaceAll(".*\\$", ""));
+            assertEquals(
+                    "[pemja]",
+                    interpreter.invoke(
+                            "test_pyjobject.test_lazy_members", new StringJoiner(",", "[", "]")));
+        }
+    }
+
+    @Test
+    public void testCallOverloadedJavaMethods() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            assertEquals(
+                    "a12.5true[1]a12.5true[1]",
+                    interpreter.invoke(
+                            "test_pyjobject.test_call_overloads",
+                            new StringBuilder(),
+                            new ArrayList<>(Arrays.asList(1L))));
+        }
+    }
+
+    @Test
+    public void testClassAttrsCachedByClassIdentity() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        URL location = TestObject.class.getProtectionDomain().getCodeSource().getLocation();
+        try (URLClassLoader loader = new URLClassLoader(new URL[] {location}, null)) {
+            Object isolated = loader.loadClass(TestObject.class.getName()).newInstance();
+            assertNotEquals(TestObject.class, isolated.getClass());
+
+            for (int i = 0; i < 2; i++) {
+                try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+                    interpreter.exec("import test_pyjobject");
+                    assertEquals(
+                            "testBoolean_boolean",
+                            interpreter.invoke(
+                                    "test_pyjobject.test_call_method",
+                                    new TestObject<>(),
+                                    "testBoolean",
+                                    true));
+                    assertEquals(
+                            "testBoolean_boolean",
+                            interpreter.invoke(
+                                    "test_pyjobject.test_call_method",
+                                    isolated,
+                                    "testBoolean",
+                                    true));
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testPyListAndPyDictViews() throws Exception {
+        PythonInterpreterConfig config = PythonInterpreterConfig.newBuilder().build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("table = {i: str(i) for i in range(1000)}");
+            interpreter.exec("values = list(range(10))");
+
+            try (PyDict table = interpreter.get("table", PyDict.class);
+                    PyList values = interpreter.get("values", PyList.class)) {
+                assertEquals(1000, table.size());
+                assertEquals("42", table.get(42L));
+                assertEquals("42", table.get(42));
+                assertNull(table.get(-1L));
+                assertTrue(table.containsKey(999L));
+                assertFalse(table.containsKey("999"));
+                assertTrue(table.containsValue("999"));
+                assertEquals(new HashMap<>(table), table);
+
+                // the views are backed by the live Python objects
+                interpreter.exec("table[1000] = '1000'");
+                assertEquals(1001, table.size());
+                assertEquals("1000", table.get(1000L));
+
+                assertEquals(10, values.size());
+                assertEquals(3L, values.get(3));
+                assertTrue(values.contains(5L));
+                assertFalse(values.contains(10L));
+                assertEquals(7, values.indexOf(7L));
+                assertEquals(Arrays.asList(0L, 1L, 2L, 3L, 4L, 5L, 6L, 7L, 8L, 9L), values);
+                assertEquals(Arrays.asList(2L, 3L), values.subList(2, 4));
+                try {
+                    values.get(10);
+                    fail("IndexOutOfBoundsException is expected.");
+                } catch (IndexOutOfBoundsException ignored) {
+                    // expected
+                }
+                try {
+                    values.add(10L);
+                    fail("UnsupportedOperationException is expected.");
+                } catch (UnsupportedOperationException ignored) {
+                    // expected
+                }
+            }
+
+            // Python lists and dicts are still copied by default
+            assertEquals(HashMap.class, interpreter.get("table").getClass());
+            assertEquals(ArrayList.class, interpreter.get("values").getClass());
+        }
+    }
+
+    @Test
+    public void testIterateJavaCollection() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+            // covers empty, partial and exactly filled chunks
+            for (int size : new int[] {0, 1, 63, 64, 65, 128, 1000}) {
+                List<Long> list = new ArrayList<>();
+                long sum = 0;
+                for (long i = 0; i < size; i++) {
+                    list.add(i);
+                    sum += i;
+                }
+                assertEquals(
+                        sum, interpreter.invoke("test_pyjobject.test_iterate_collection", list));
+                assertEquals(
+                        sum,
+                        interpreter.invoke(
+                                "test_pyjobject.test_iterate_collection", new HashSet<>(list)));
+            }
+
+            // a modification is only detected when the next chunk is fetched
+            List<Long> list = new ArrayList<>(Arrays.asList(1L, 2L, 3L));
+            assertEquals(
+                    3L, interpreter.invoke("test_pyjobject.test_modify_while_iterating", list));
+            assertEquals(4, list.size());
+            list.clear();
+            for (long i = 0; i < 100; i++) {
+                list.add(i);
+            }
+            assertTrue(
+                    ((String)
+                                    interpreter.invoke(
+                                            "test_pyjobject.test_modify_while_iterating", list))
+                            .contains("ConcurrentModificationException"));
+        }
+    }
+
+    @Test
+    public void testConversionPolicy() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .addPythonPaths(testDir)
+                        .setConversionPolicy(
+                                PythonInterpreterConfig.ConversionPolicy.EAGER_COPY)
+                        .build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_pyjobject");
+
+            Map<String, Long> map = new HashMap<>();
+            map.put("pemja", 1L);
+            map.put("java", 2L);
+            map.put("python", 3L);
+            ArrayList<String> keys = new ArrayList<>(map.keySet());
+
+            assertEquals("list", interpreter.invoke("test_pyjobject.test_type_name", keys));
+            assertEquals("dict", interpreter.invoke("test_pyjobject.test_type_name", map));
+            assertEquals(
+                    "list", interpreter.invoke("test_pyjobject.test_type_name", map.values()));
+            assertEquals(keys, interpreter.invoke("test_pyjobject.test_list", keys));
+
+            assertEquals(
+                    "PyJList",
+                    interpreter.invoke(
+                            PythonInterpreterConfig.ConversionPolicy.LAZY_PROXY,
+                            "test_pyjobject.test_type_name",
+                            keys));
+            assertEquals("list", interpreter.invoke("test_pyjobject.test_type_name", keys));
+
+            interpreter.setConversionPolicy(PythonInterpreterConfig.ConversionPolicy.LAZY_PROXY);
+            assertEquals("PyJDict", interpreter.invoke("test_pyjobject.test_type_name", map));
+        }
+    }
+
+    @Test
+    public void testArrowRecordBatch() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_arrow");
+            assumeTrue((Boolean) interpreter.invoke("test_arrow.has_pyarrow"));
+
+            Object[] input = (Object[]) interpreter.invoke("test_arrow.new_c_structs");
+            Object[] output = (Object[]) interpreter.invoke("test_arrow.new_c_structs");
+            interpreter.invoke("test_arrow.export_record_batch", input[0], input[1]);
+
+            try (PyObject batch =
+                            interpreter.importRecordBatch((Long) input[0], (Long) input[1]);
+                    PyObject result =
+                            (PyObject) interpreter.invoke("test_arrow.test_record_batch", batch)) {
+                // the ownership of the imported structs has been moved to pyarrow
+                assertTrue((Boolean) interpreter.invoke("test_arrow.is_released", input));
+                result.exportRecordBatch((Long) output[0], (Long) output[1]);
+            }
+
+            Map<String, Object> expected = new HashMap<>();
+            List<Object> a = new ArrayList<>();
+            a.add(2L);
+            a.add(4L);
+            a.add(6L);
+            List<Object> b = new ArrayList<>();
+            b.add("a");
+            b.add("b");
+            b.add(null);
+            expected.put("a", a);
+            expected.put("b", b);
+            assertEquals(
+                    expected,
+                    interpreter.invoke("test_arrow.read_record_batch", output[0], output[1]));
+        }
+    }
+
     @Test
     public void testMultiThreadSameEnvironment() throws InterruptedException {
         File file1 = new File(tmpDirPath + File.separatorChar + "file1");
@@ -494,6 +832,425 @@ public class PythonInterpreterTest {
         assertNotEquals(path1.get(), path2.get());
     }
 
+    @Test
+    public void testSubInterpreterOwnGil() throws InterruptedException {
+        try (PythonInterpreter interpreter =
+                new PythonInterpreter(PythonInterpreterConfig.newBuilder().build())) {
+            interpreter.exec("import sys");
+            interpreter.exec("supported = sys.version_info >= (3, 12)");
+            assumeTrue(interpreter.get("supported", Boolean.class));
+        }
+
+        AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+        List<Thread> threads = new ArrayList<>();
+        for (int i = 0; i < 2; i++) {
+            threads.add(
+                    new Thread(
+                            () -> {
+                                PythonInterpreterConfig config =
+                                        PythonInterpreterConfig.newBuilder()
+                                                .setExcType(
+                                                        PythonInterpreterConfig.ExecType
+                                                                .SUB_INTERPRETER_OWN_GIL)
+                                                .addPythonPaths(testDir)
+                                                .build();
+                                try (PythonInterpreter interpreter =
+                                        new PythonInterpreter(config)) {
+                                    interpreter.exec("import test_pyjobject");
+                                    assertEquals(
+                                            "StringBuilder",
+                                            interpreter.invoke(
+                                                    "test_pyjobject.test_type_name",
+                                                    new StringBuilder()));
+                                    interpreter.exec("total = sum(i * i for i in range(100000))");
+                                    assertEquals(
+                                            333328333350000L,
+                                            (long) interpreter.get("total", Long.class));
+                                } catch (Throwable throwable) {
+                                    exceptionReference.compareAndSet(null, throwable);
+                                }
+                            }));
+        }
+
+        for (Thread thread : threads) {
+            thread.start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        assertNull(exceptionReference.get());
+    }
+
+    @Test
+    public void testWarmUpTemplate() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .addPythonPaths(testDir)
+                        .setWarmUpCode(
+                                "import sys\n"
+                                        + "warm_ups = getattr(sys, 'pemja_warm_ups', 0) + 1\n"
+                                        + "sys.pemja_warm_ups = warm_ups\n"
+                                        + "def triple(x):\n"
+                                        + "    return 3 * x\n"
+                                        + "def count():\n"
+                                        + "    global warm_ups\n"
+                                        + "    warm_ups += 1\n"
+                                        + "    return warm_ups\n"
+                                        + "def scale(x, *, factor=4):\n"
+                                        + "    return x * factor\n"
+                                        + "def adder(n):\n"
+                                        + "    def add(x):\n"
+                                        + "        return x + n\n"
+                                        + "    return add\n"
+                                        + "add_five = adder(5)")
+                        .build();
+
+        try (PythonInterpreter first = new PythonInterpreter(config);
+                PythonInterpreter second = new PythonInterpreter(config)) {
+            first.set("warm_ups", 0L);
+            assertEquals(1L, (long) second.get("warm_ups", Long.class));
+            assertEquals(6L, second.invoke("triple", 2));
+            // the functions use the globals of their interpreter
+            assertEquals(1L, first.invoke("count"));
+            assertEquals(2L, second.invoke("count"));
+            assertEquals(1L, (long) first.get("warm_ups", Long.class));
+            // the keyword-only defaults are kept and the closures are shared
+            assertEquals(8L, second.invoke("scale", 2));
+            assertEquals(7L, second.invoke("add_five", 2));
+        }
+
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            // the warm-up code has only run once
+            interpreter.exec("total_warm_ups = sys.pemja_warm_ups");
+            assertEquals(1L, (long) interpreter.get("total_warm_ups", Long.class));
+            assertEquals(9L, interpreter.invoke("triple", 3));
+        }
+    }
+
+    @Test
+    public void testRecycleSubInterpreter() throws InterruptedException {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .setExcType(PythonInterpreterConfig.ExecType.SUB_INTERPRETER)
+                        .addPythonPaths(testDir)
+                        .setMaxIdleInterpreters(1)
+                        .build();
+
+        long marker;
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import sys\nsys.pemja_marker = object()");
+            interpreter.exec("marker = id(sys.pemja_marker)");
+            marker = interpreter.get("marker", Long.class);
+        }
+
+        // the idle sub interpreter is reused by another thread with its globals restored
+        AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+        Thread thread =
+                new Thread(
+                        () -> {
+                            try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+                                interpreter.exec("recycled = 'marker' not in globals()");
+                                assertTrue(interpreter.get("recycled", Boolean.class));
+                                interpreter.exec("import sys\nmarker = id(sys.pemja_marker)");
+                                assertEquals(marker, (long) interpreter.get("marker", Long.class));
+                                // Java methods are called with the JNIEnv of this thread
+                                interpreter.exec("def append(sb):\n    return sb.append('pemja')");
+                                assertEquals(
+                                        "pemja",
+                                        interpreter.invoke("append", new StringBuilder())
+                                                .toString());
+                            } catch (Throwable throwable) {
+                                exceptionReference.compareAndSet(null, throwable);
+                            }
+                        });
+        thread.start();
+        thread.join();
+        assertNull(exceptionReference.get());
+
+        // the idle sub interpreter expires at once, so a new one is created
+        PythonInterpreterConfig expiringConfig =
+                PythonInterpreterConfig.newBuilder()
+                        .setExcType(PythonInterpreterConfig.ExecType.SUB_INTERPRETER)
+                        .addPythonPaths(testDir)
+                        .setMaxIdleInterpreters(1)
+                        .setIdleInterpreterTtl(Duration.ZERO)
+                        .build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(expiringConfig)) {
+            interpreter.exec("import sys\nsys.pemja_marker = object()");
+        }
+        Thread.sleep(1);
+        try (PythonInterpreter interpreter = new PythonInterpreter(expiringConfig)) {
+            interpreter.exec("import sys\nrecycled = hasattr(sys, 'pemja_marker')");
+            assertFalse(interpreter.get("recycled", Boolean.class));
+        }
+    }
+
+    @Test
+    public void testInterruptLongRunningCall() throws Exception {
+        try (PythonInterpreter interpreter =
+                new PythonInterpreter(PythonInterpreterConfig.newBuilder().build())) {
+            interpreter.exec("def spin():\n    while True:\n        pass");
+            interpreter.exec("def add(a, b):\n    return a + b");
+
+            try {
+                interpreter.invoke(Duration.ofMillis(100), "spin");
+                fail("The call should be interrupted by its deadline.");
+            } catch (PythonTimeoutException e) {
+                assertTrue(e.getMessage().contains("PythonTimeoutError"));
+            }
+
+            // the interpreter is still usable and the deadlines of returned calls never fire
+            assertEquals(3L, interpreter.invoke(Duration.ofMillis(100), "add", 1, 2));
+            Thread.sleep(200);
+            assertEquals(5L, interpreter.invoke("add", 2, 3));
+
+            Thread thread =
+                    new Thread(
+                            () -> {
+                                try {
+                                    Thread.sleep(100);
+                                } catch (InterruptedException ignored) {
+                                }
+                                interpreter.interrupt();
+                            });
+            thread.start();
+            try {
+                interpreter.invoke("spin");
+                fail("The call should be interrupted by another thread.");
+            } catch (Exception e) {
+                assertTrue(e instanceof PythonTimeoutException);
+            }
+            thread.join();
+            assertEquals(7L, interpreter.invoke("add", 3, 4));
+        }
+    }
+
+    @Test
+    public void testInterruptInterpretersOfSameThread() {
+        PythonInterpreterConfig config = PythonInterpreterConfig.newBuilder().build();
+        try (PythonInterpreter first = new PythonInterpreter(config);
+                PythonInterpreter second = new PythonInterpreter(config)) {
+            first.exec("def add(a, b):\n    return a + b");
+            second.exec("def spin():\n    while True:\n        pass");
+
+            // the interrupt of the first would be raised in the second
+            try {
+                first.invoke(Duration.ofMillis(100), "add", 1, 2);
+                fail("The call of the first interpreter should be rejected.");
+            } catch (IllegalStateException e) {
+                assertTrue(e.getMessage().contains("deadline"));
+            }
+
+            try {
+                second.invoke(Duration.ofMillis(100), "spin");
+                fail("The call should be interrupted by its deadline.");
+            } catch (PythonTimeoutException e) {
+                assertTrue(e.getMessage().contains("PythonTimeoutError"));
+            }
+            assertEquals(3L, first.invoke("add", 1, 2));
+        }
+    }
+
+    @Test
+    public void testInvokeAsync() throws Exception {
+        CompletableFuture<Object> pending;
+        try (PythonInterpreter interpreter =
+                new PythonInterpreter(PythonInterpreterConfig.newBuilder().build())) {
+            interpreter.exec(
+                    "import asyncio\n"
+                            + "async def delayed_add(a, b):\n"
+                            + "    await asyncio.sleep(0.2)\n"
+                            + "    return a + b\n"
+                            + "async def fail():\n"
+                            + "    raise ValueError('failed')\n"
+                            + "async def forever():\n"
+                            + "    await asyncio.sleep(3600)");
+
+            // the coroutines overlap in the event loop instead of running one by one
+            long start = System.nanoTime();
+            List<CompletableFuture<Object>> futures = new ArrayList<>();
+            for (int i = 0; i < 10; i++) {
+                futures.add(interpreter.invokeAsync("delayed_add", i, 1));
+            }
+            for (int i = 0; i < 10; i++) {
+                assertEquals((long) i + 1, futures.get(i).get());
+            }
+            assertTrue(System.nanoTime() - start < TimeUnit.MILLISECONDS.toNanos(1500));
+
+            try {
+                interpreter.invokeAsync("fail").get();
+                fail("The errors of coroutines should complete the futures exceptionally.");
+            } catch (ExecutionException e) {
+                assertTrue(e.getCause() instanceof PythonException);
+                assertTrue(e.getCause().getMessage().contains("failed"));
+            }
+
+            pending = interpreter.invokeAsync("forever");
+        }
+        // the coroutines still running are cancelled once the interpreter is closed
+        assertTrue(pending.isCancelled());
+    }
+
+    @Test
+    public void testFreeThreadedScaling() throws InterruptedException {
+        try (PythonInterpreter interpreter =
+                new PythonInterpreter(PythonInterpreterConfig.newBuilder().build())) {
+            interpreter.exec("import sys");
+            interpreter.exec("gil_enabled = getattr(sys, '_is_gil_enabled', lambda: True)()");
+            assumeTrue(!interpreter.get("gil_enabled", Boolean.class));
+        }
+        int numThreads = Math.min(4, Runtime.getRuntime().availableProcessors());
+        assumeTrue(numThreads >= 2);
+
+        String work =
+                "def work(n):\n"
+                        + "    total = 0\n"
+                        + "    for i in range(n):\n"
+                        + "        total += i * i\n"
+                        + "    return total";
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .setExcType(PythonInterpreterConfig.ExecType.FREE_THREADED)
+                        .build();
+
+        long sequentialNanos;
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec(work);
+            interpreter.invoke("work", 100000);
+            long start = System.nanoTime();
+            for (int i = 0; i < numThreads; i++) {
+                interpreter.invoke("work", 2000000);
+            }
+            sequentialNanos = System.nanoTime() - start;
+        }
+
+        CountDownLatch ready = new CountDownLatch(numThreads);
+        CountDownLatch go = new CountDownLatch(1);
+        AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+        List<Thread> threads = new ArrayList<>();
+        for (int i = 0; i < numThreads; i++) {
+            threads.add(
+                    new Thread(
+                            () -> {
+                                try (PythonInterpreter interpreter =
+                                        new PythonInterpreter(config)) {
+                                    interpreter.exec(work);
+                                    interpreter.invoke("work", 100000);
+                                    ready.countDown();
+                                    go.await();
+                                    interpreter.invoke("work", 2000000);
+                                } catch (Throwable throwable) {
+                                    exceptionReference.compareAndSet(null, throwable);
+                                    ready.countDown();
+                                }
+                            }));
+        }
+
+        for (Thread thread : threads) {
+            thread.start();
+        }
+        ready.await();
+        long start = System.nanoTime();
+        go.countDown();
+        for (Thread thread : threads) {
+            thread.join();
+        }
+        long parallelNanos = System.nanoTime() - start;
+
+        assertNull(exceptionReference.get());
+        // the same work runs in parallel rather than one call after another
+        assertTrue(parallelNanos < sequentialNanos * 0.75);
+    }
+
+    @Test
+    public void testSession() throws InterruptedException {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+            try (PythonSession session = interpreter.session()) {
+                interpreter.set("a", 1);
+                interpreter.set("b", 2);
+                interpreter.exec("c = a + b");
+                assertEquals(3L, (long) interpreter.get("c", Long.class));
+
+                // Java methods called in the session release and acquire the GIL again
+                interpreter.exec("import test_callback_java");
+                assertEquals(
+                        "pemja",
+                        interpreter.invoke("test_callback_java.test_import_java_class"));
+
+                Thread thread = new Thread(() -> interpreter.exec("d = 4"));
+                thread.setUncaughtExceptionHandler((t, e) -> exceptionReference.set(e));
+                thread.start();
+                thread.join();
+            }
+            assertTrue(exceptionReference.get() instanceof IllegalStateException);
+
+            // the interpreter is usable by other threads once the session is closed
+            Thread thread = new Thread(() -> interpreter.exec("d = 4"));
+            thread.start();
+            thread.join();
+            assertEquals(4L, (long) interpreter.get("d", Long.class));
+        }
+    }
+
+    @Test
+    public void testSessionUnderGilContention() throws InterruptedException {
+        AtomicBoolean running = new AtomicBoolean(true);
+        Thread contender =
+                new Thread(
+                        () -> {
+                            try (PythonInterpreter interpreter =
+                                    new PythonInterpreter(
+                                            PythonInterpreterConfig.newBuilder().build())) {
+                                interpreter.exec(
+                                        "def spin():\n"
+                                                + "    for _ in range(1000000):\n"
+                                                + "        pass");
+                                while (running.get()) {
+                                    interpreter.invoke("spin");
+                                }
+                            }
+                        });
+
+        try (PythonInterpreter interpreter =
+                new PythonInterpreter(PythonInterpreterConfig.newBuilder().build())) {
+            interpreter.exec("def add(a, b):\n    return a + b");
+            contender.start();
+
+            // set 5 variables, invoke and get 2 results, i.e. 8 GIL handoffs per iteration
+            long start = System.nanoTime();
+            for (int i = 0; i < 10; i++) {
+                runCallSequence(interpreter, i);
+            }
+            long plainNanos = System.nanoTime() - start;
+
+            start = System.nanoTime();
+            for (int i = 0; i < 10; i++) {
+                try (PythonSession session = interpreter.session()) {
+                    runCallSequence(interpreter, i);
+                }
+            }
+            long sessionNanos = System.nanoTime() - start;
+
+            // every call waits for the switch interval of the contender without a session
+            assertTrue(sessionNanos < plainNanos);
+        } finally {
+            running.set(false);
+            contender.join();
+        }
+    }
+
+    private static void runCallSequence(PythonInterpreter interpreter, int i) {
+        for (int j = 0; j < 5; j++) {
+            interpreter.set("v" + j, i + j);
+        }
+        assertEquals(2L * i + 1, (long) interpreter.invoke("add", i, i + 1));
+        assertEquals((long) i, (long) interpreter.get("v0", Long.class));
+        assertEquals(i + 4L, (long) interpreter.get("v4", Long.class));
+    }
+
     @Test
     public void testMultiThread() throws InterruptedException {
         AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
@@ -665,12 +1422,248 @@ public class PythonInterpreterTest {
                 TestObject object = new TestObject();
                 interpreter.invoke("test_callback_java.test_callback_with_all_types", object);
                 interpreter.invoke("test_callback_java.test_java_call_python", object, interpreter);
+                interpreter.invoke("test_callback_java.test_no_gil_release", object);
             }
         } catch (Exception e) {
             throw new RuntimeException("Failed to call test_call_java in test_callback_java.py", e);
         }
     }
 
+    @Test
+    @SuppressWarnings("unchecked")
+    public void testPythonCallableAsInterface() {
+        PythonInterpreterConfig config = PythonInterpreterConfig.newBuilder().build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("def add_one(x):\n    return x + 1");
+            interpreter.exec("is_even = lambda x: x % 2 == 0");
+            interpreter.exec("hello = lambda: 'pemja'");
+            interpreter.exec("twice = lambda s: s * 2");
+
+            Function<Object, Object> addOne = interpreter.asInterface(Function.class, "add_one");
+            assertEquals(2L, addOne.apply(1));
+
+            IntPredicate isEven = interpreter.asInterface(IntPredicate.class, "is_even");
+            assertEquals(
+                    Arrays.asList(0, 2, 4),
+                    IntStream.range(0, 6).filter(isEven).boxed().collect(Collectors.toList()));
+
+            Supplier<String> hello = interpreter.asInterface(Supplier.class, "hello");
+            assertEquals("pemja", hello.get());
+
+            Map<String, Object> cache = new HashMap<>();
+            Function<String, Object> twice = interpreter.asInterface(Function.class, "twice");
+            assertEquals("pemjapemja", cache.computeIfAbsent("pemja", twice));
+
+            // the default methods run their Java implementations
+            Greeter greeter = interpreter.asInterface(Greeter.class, "hello");
+            assertEquals("Hello, pemja", greeter.greet());
+        }
+    }
+
+    @Test
+    public void testInterpreterPool() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreterPool pool =
+                new PythonInterpreterPool(config, 3, "def square(x):\n    return x * x")) {
+            List<CompletableFuture<Object>> results = new ArrayList<>();
+            for (int i = 0; i < 100; i++) {
+                results.add(pool.submit("square", i));
+            }
+            for (int i = 0; i < 100; i++) {
+                assertEquals((long) i * i, results.get(i).get());
+            }
+
+            PythonInterpreterPool.Metrics metrics = pool.getMetrics();
+            assertEquals(100, metrics.getCompletedCalls());
+            assertEquals(0, metrics.getQueueDepth());
+            assertTrue(metrics.getP50LatencyNanos() <= metrics.getP99LatencyNanos());
+            assertEquals(3, metrics.getWorkerUtilization().length);
+        }
+    }
+
+    @Test
+    public void testSharedInterpreter() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        SharedPythonInterpreter interpreter = new SharedPythonInterpreter(config);
+        try {
+            interpreter.exec("def square(x):\n    return x * x");
+
+            AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+            List<Thread> threads = new ArrayList<>();
+            for (int i = 0; i < 4; i++) {
+                threads.add(
+                        new Thread(
+                                () -> {
+                                    try {
+                                        for (int j = 0; j < 50; j++) {
+                                            assertEquals(
+                                                    (long) j * j, interpreter.invoke("square", j));
+                                        }
+                                    } catch (Throwable throwable) {
+                                        exceptionReference.compareAndSet(null, throwable);
+                                    }
+                                }));
+            }
+            for (Thread thread : threads) {
+                thread.start();
+            }
+            for (Thread thread : threads) {
+                thread.join();
+            }
+            assertNull(exceptionReference.get());
+
+            List<CompletableFuture<Object>> results = new ArrayList<>();
+            for (int i = 0; i < 100; i++) {
+                results.add(interpreter.submit("square", i));
+            }
+            for (int i = 0; i < 100; i++) {
+                assertEquals((long) i * i, results.get(i).get());
+            }
+        } finally {
+            interpreter.close();
+        }
+
+        try {
+            interpreter.invoke("square", 1);
+            fail("The calls of a closed interpreter should be rejected.");
+        } catch (RejectedExecutionException e) {
+            // expected
+        }
+    }
+
+    @Test
+    public void testProcessInterpreter() throws Exception {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .addPythonPaths(testDir)
+                        .setExcType(PythonInterpreterConfig.ExecType.PROCESS)
+                        .build();
+        ProcessPythonInterpreter interpreter = new ProcessPythonInterpreter(config, 2);
+        try {
+            interpreter.exec("import math\ndef square(x):\n    return x * x");
+            interpreter.set("offset", 3);
+            interpreter.exec("def add_offset(x):\n    return x + offset");
+
+            Map<String, Object> map = new HashMap<>();
+            map.put("a", Arrays.asList(1, 2.5, "c"));
+            interpreter.set("value", new Object[] {null, true, new byte[] {1}, map});
+            Object[] value = interpreter.get("value", Object[].class);
+            assertNull(value[0]);
+            assertEquals(true, value[1]);
+            assertArrayEquals(new byte[] {1}, (byte[]) value[2]);
+            assertEquals(Arrays.asList(1L, 2.5, "c"), ((Map<?, ?>) value[3]).get("a"));
+            assertEquals(
+                    new BigInteger("1267650600228229401496703205376"),
+                    interpreter.invoke("math.prod", new long[] {1L << 50, 1L << 50}));
+            interpreter.exec("import decimal\nhalf = decimal.Decimal('1.5')");
+            assertEquals(new BigDecimal("1.5"), interpreter.get("half"));
+
+            AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
+            List<Thread> threads = new ArrayList<>();
+            for (int i = 0; i < 4; i++) {
+                threads.add(
+                        new Thread(
+                                () -> {
+                                    try {
+                                        for (int j = 0; j < 50; j++) {
+                                            assertEquals(
+                                                    (long) j * j, interpreter.invoke("square", j));
+                                            assertEquals(
+                                                    (long) j + 3,
+                                                    interpreter.invoke("add_offset", j));
+                                        }
+                                    } catch (Throwable throwable) {
+                                        exceptionReference.compareAndSet(null, throwable);
+                                    }
+                                }));
+            }
+            for (Thread thread : threads) {
+                thread.start();
+            }
+            for (Thread thread : threads) {
+                thread.join();
+            }
+            assertNull(exceptionReference.get());
+
+            try {
+                interpreter.invoke("square", "a");
+                fail("The errors of Python should be thrown.");
+            } catch (RuntimeException e) {
+                assertTrue(e.getCause() instanceof PythonException);
+            }
+            assertEquals(4L, interpreter.invoke("square", 2));
+
+            // the directory is only created by the first worker, so the workers differ
+            String marker = new File(tmpDirPath, "marker").getAbsolutePath();
+            try {
+                interpreter.exec(String.format("import os\nos.mkdir(r'%s')", marker));
+                fail("The request failing in some of the workers should close the interpreter.");
+            } catch (IllegalStateException e) {
+                assertTrue(e.getMessage().contains("[1] of 2"));
+            }
+            try {
+                interpreter.invoke("square", 2);
+                fail("The calls of a closed interpreter should be rejected.");
+            } catch (IllegalStateException e) {
+                // expected
+            }
+        } finally {
+            interpreter.close();
+        }
+    }
+
+    @Test
+    public void testProcessInterpreterWorkerExit() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder()
+                        .setExcType(PythonInterpreterConfig.ExecType.PROCESS)
+                        .build();
+        ProcessPythonInterpreter interpreter = new ProcessPythonInterpreter(config, 2);
+        try {
+            interpreter.exec("import os\ndef square(x):\n    return x * x");
+            try {
+                interpreter.invoke("os._exit", 1);
+                fail("The exit of the worker should be thrown.");
+            } catch (IllegalStateException e) {
+                // expected
+            }
+
+            // the calls run on the other worker only
+            for (int i = 0; i < 4; i++) {
+                assertEquals(4L, interpreter.invoke("square", 2));
+            }
+            interpreter.set("offset", 3);
+            assertEquals(3L, interpreter.get("offset"));
+
+            try {
+                interpreter.invoke("os._exit", 1);
+                fail("The exit of the worker should be thrown.");
+            } catch (IllegalStateException e) {
+                // expected
+            }
+            try {
+                interpreter.invoke("square", 2);
+                fail("The calls should fail once all the workers are stopped.");
+            } catch (IllegalStateException e) {
+                assertTrue(e.getMessage().contains("have been stopped"));
+            }
+        } finally {
+            interpreter.close();
+        }
+    }
+
+    @Test
+    public void testImportJavaClasses() {
+        PythonInterpreterConfig config =
+                PythonInterpreterConfig.newBuilder().addPythonPaths(testDir).build();
+        try (PythonInterpreter interpreter = new PythonInterpreter(config)) {
+            interpreter.exec("import test_callback_java");
+            assertEquals("pemja", interpreter.invoke("test_callback_java.test_import_java_class"));
+        }
+    }
+
     @Test
     public void testCallbackJavaInMultiThread() throws InterruptedException {
         AtomicReference<Throwable> exceptionReference = new AtomicReference<>();
@@ -727,6 +1720,16 @@ public class PythonInterpreterTest {
         }
     }
 
+    /** A functional interface having a default method. */
+    public interface Greeter {
+
+        String name();
+
+        default String greet() {
+            return "Hello, " + name();
+        }
+    }
+
     public static final class TestObject<T> {
 
         /* ----------------------------------- test boolean ------------------------------------- */
@@ -868,6 +1871,29 @@ public class PythonInterpreterTest {
 
         /* -------------------------------------------------------------------------------------- */
 
+        /* ----------------------------------- test many args ----------------------------------- */
+
+        public long testManyArgs(
+                int a1, int a2, int a3, int a4, int a5, int a6, int a7, int a8, long a9) {
+            return a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9;
+        }
+
+        /* -------------------------------------------------------------------------------------- */
+
+        /* ----------------------------------- test no gil release ------------------------------ */
+
+        @NoGilRelease
+        public int testNoGilRelease(int a, int b) {
+            return a + b;
+        }
+
+        @NoGilRelease
+        public void testNoGilReleaseSleep(long millis) throws InterruptedException {
+            Thread.sleep(millis);
+        }
+
+        /* -------------------------------------------------------------------------------------- */
+
         /* ----------------------------------- test bytes --------------------------------------- */
 
         public String testBytes(byte[] arg) {